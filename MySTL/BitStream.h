@@ -0,0 +1,181 @@
+#ifndef BITSTREAM_H
+#define BITSTREAM_H
+#include <cstdint>
+#include <cstring>
+#include <cstddef>
+
+// 按大端序读写 64 位字（位流统一采用 MSB 优先，便于按前缀查表解码）
+inline void storeBE64(unsigned char* p, uint64_t w) {
+    for (int i = 7; i >= 0; i--) {
+        p[i] = (unsigned char)w;
+        w >>= 8;
+    }
+}
+
+inline uint64_t loadBE64(const unsigned char* p) {
+    uint64_t w = 0;
+    for (int i = 0; i < 8; i++) w = (w << 8) | p[i];
+    return w;
+}
+
+// 位写出器：编码先攒进 64 位累加器，满 64 位时整字写入缓冲区
+class BitWriter {
+private:
+    unsigned char* _buf;
+    size_t _cap;
+    size_t _len;    // 已写入缓冲区的字节数
+    uint64_t _acc;  // 累加器，低 _accBits 位有效
+    int _accBits;
+
+    void reserve(size_t need) {
+        if (need <= _cap) return;
+        size_t c = _cap * 2 > need ? _cap * 2 : need;
+        unsigned char* nb = new unsigned char[c];
+        memcpy(nb, _buf, _len);
+        delete[] _buf;
+        _buf = nb;
+        _cap = c;
+    }
+
+public:
+    BitWriter(size_t initialBytes = 1 << 16) : _cap(initialBytes < 16 ? 16 : initialBytes), _len(0), _acc(0), _accBits(0) {
+        _buf = new unsigned char[_cap];
+    }
+    ~BitWriter() { delete[] _buf; }
+
+    BitWriter(const BitWriter&) = delete;
+    BitWriter& operator=(const BitWriter&) = delete;
+
+    // 写入 bits 的低 n 位（0 <= n <= 64），高位先写
+    void write(uint64_t bits, int n) {
+        if (n == 0) return;
+        if (n < 64) bits &= (1ULL << n) - 1;
+        if (_accBits + n < 64) {
+            _acc = (_acc << n) | bits;
+            _accBits += n;
+            return;
+        }
+        int room = 64 - _accBits; // 本字还能放下的位数（<= n）
+        int rest = n - room;      // 溢出到下一个字的位数
+        uint64_t word = (_accBits == 0 ? 0 : _acc << room) | (bits >> rest);
+        reserve(_len + 8);
+        storeBE64(_buf + _len, word);
+        _len += 8;
+        _acc = rest == 0 ? 0 : bits & ((1ULL << rest) - 1);
+        _accBits = rest;
+    }
+
+    // 按字节写入（调用前应已字节对齐，否则按位写入）
+    void writeBytes(const unsigned char* p, size_t n) {
+        if (_accBits % 8 != 0) {
+            for (size_t i = 0; i < n; i++) write(p[i], 8);
+            return;
+        }
+        flush();
+        reserve(_len + n);
+        memcpy(_buf + _len, p, n);
+        _len += n;
+    }
+
+    // 把累加器中剩余的位补 0 到整字节后写出，之后位流字节对齐
+    void flush() {
+        if (_accBits == 0) return;
+        int pad = (8 - _accBits % 8) % 8;
+        uint64_t w = _acc << pad;
+        int bytes = (_accBits + pad) / 8;
+        reserve(_len + bytes);
+        for (int i = bytes - 1; i >= 0; i--) {
+            _buf[_len + i] = (unsigned char)w;
+            w >>= 8;
+        }
+        _len += bytes;
+        _acc = 0;
+        _accBits = 0;
+    }
+
+    // 已写入的总位数（不含 flush 的填充位）
+    uint64_t bitCount() const { return (uint64_t)_len * 8 + _accBits; }
+
+    // 缓冲区内容（先 flush 才包含最后不足一个字的位）
+    const unsigned char* data() const { return _buf; }
+    size_t byteSize() const { return _len; }
+
+    void clear() {
+        _len = 0;
+        _acc = 0;
+        _accBits = 0;
+    }
+};
+
+// 位读取器：64 位缓冲区左对齐保存待读的位，一次补充最多 7 个字节
+class BitReader {
+private:
+    const unsigned char* _p;
+    const unsigned char* _end;
+    uint64_t _buf;   // 高 _bits 位有效
+    int _bits;
+    uint64_t _total; // 已消费的位数
+
+public:
+    BitReader(const unsigned char* data = nullptr, size_t n = 0) { reset(data, n); }
+
+    void reset(const unsigned char* data, size_t n) {
+        _p = data;
+        _end = data + n;
+        _buf = 0;
+        _bits = 0;
+        _total = 0;
+    }
+
+    // 保证缓冲区至少有 56 位（越过末尾的部分补 0）
+    void refill() {
+        if (_end - _p >= 8) {
+            _buf |= loadBE64(_p) >> _bits;
+            _p += (63 - _bits) >> 3;
+            _bits |= 56;
+            return;
+        }
+        while (_bits <= 56) {
+            uint64_t b = _p < _end ? *_p++ : 0;
+            _buf |= b << (56 - _bits);
+            _bits += 8;
+        }
+    }
+
+    // 查看接下来的 n 位（1 <= n <= 56，调用前需 refill）
+    uint64_t peek(int n) const { return _buf >> (64 - n); }
+
+    // 丢弃 n 位（n <= 当前缓冲位数）
+    void consume(int n) {
+        _buf <<= n;
+        _bits -= n;
+        _total += n;
+    }
+
+    // 读取 n 位（0 <= n <= 64）
+    uint64_t read(int n) {
+        if (n == 0) return 0;
+        if (n > 56) {
+            uint64_t hi = read(n - 32);
+            return (hi << 32) | read(32);
+        }
+        if (_bits < n) refill();
+        uint64_t v = peek(n);
+        consume(n);
+        return v;
+    }
+
+    // 跳到下一个字节边界
+    void alignToByte() {
+        int pad = (int)((8 - _total % 8) % 8);
+        if (pad) read(pad);
+    }
+
+    // 缓冲区中现有的位数
+    int available() const { return _bits; }
+
+    // 已消费的位数
+    uint64_t position() const { return _total; }
+};
+
+#endif // BITSTREAM_H
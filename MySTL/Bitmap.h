@@ -0,0 +1,320 @@
+#ifndef BITMAP_H
+#define BITMAP_H
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+// 64 位字上的计数 / 定位原语（GCC/Clang 编译为 popcnt / tzcnt 指令）
+inline int popcount64(uint64_t x) {
+#if defined(__GNUC__)
+    return __builtin_popcountll(x);
+#else
+    x = x - ((x >> 1) & 0x5555555555555555ULL);
+    x = (x & 0x3333333333333333ULL) + ((x >> 2) & 0x3333333333333333ULL);
+    x = (x + (x >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    return (int)((x * 0x0101010101010101ULL) >> 56);
+#endif
+}
+
+inline int ctz64(uint64_t x) { // x != 0
+#if defined(__GNUC__)
+    return __builtin_ctzll(x);
+#else
+    int n = 0;
+    while (!(x & 1)) { x >>= 1; n++; }
+    return n;
+#endif
+}
+
+inline int highestBit64(uint64_t x) { // x != 0，返回最高置位的下标
+#if defined(__GNUC__)
+    return 63 - __builtin_clzll(x);
+#else
+    int n = 0;
+    while (x >>= 1) n++;
+    return n;
+#endif
+}
+
+// 位图：按 64 位字存储，第 k 位位于 _words[k / 64] 的第 k % 64 位（低位在前）。
+// 支持硬件 popcount、逐个枚举置位、整字批量 AND/OR/XOR/ANDNOT，
+// 以及 rank/select 索引（每 512 位一个 64 位累计值 + 每字一个 16 位块内累计值，额外空间约 4.7%）
+class Bitmap {
+private:
+    uint64_t* _words;
+    long long _nWords;  // 字数（容量 = 64 * _nWords 位）
+    long long _sz;      // 已使用的比特数（最高置位 + 1）
+
+    // rank 索引：_super[i] 为前 512 * i 位中 1 的个数，_sub[j] 为第 j 字之前、同一超块内 1 的个数
+    uint64_t* _super;
+    uint16_t* _sub;
+    bool _indexValid;
+
+    // 扩容：按两倍增长，新增部分清零
+    void expand(long long k) {
+        if (k < 64 * _nWords) return;
+        long long need = k / 64 + 1;
+        long long n = _nWords * 2 > need ? _nWords * 2 : need;
+        uint64_t* w = new uint64_t[n];
+        memcpy(w, _words, sizeof(uint64_t) * _nWords);
+        memset(w + _nWords, 0, sizeof(uint64_t) * (n - _nWords));
+        delete[] _words;
+        _words = w;
+        _nWords = n;
+    }
+
+    void init(long long n) {
+        _nWords = n > 0 ? (n + 63) / 64 : 1;
+        _words = new uint64_t[_nWords]();
+        _sz = 0;
+        _super = nullptr;
+        _sub = nullptr;
+        _indexValid = false;
+    }
+
+    void dropIndex() {
+        delete[] _super;
+        delete[] _sub;
+        _super = nullptr;
+        _sub = nullptr;
+        _indexValid = false;
+    }
+
+    // 批量操作后重新计算 _sz
+    void recomputeSize() {
+        long long w = _nWords - 1;
+        while (w >= 0 && _words[w] == 0) w--;
+        _sz = w < 0 ? 0 : 64 * w + highestBit64(_words[w]) + 1;
+    }
+
+    // 逐字二元运算（AVX2 每次 4 个字）
+    template <typename Op, typename VecOp>
+    void combine(const Bitmap& other, Op op, VecOp vop) {
+        if (other._nWords > _nWords) expand(64 * other._nWords - 1);
+        long long n = other._nWords, i = 0;
+#if defined(__AVX2__)
+        for (; i + 4 <= n; i += 4) {
+            __m256i a = _mm256_loadu_si256((const __m256i*)(_words + i));
+            __m256i b = _mm256_loadu_si256((const __m256i*)(other._words + i));
+            _mm256_storeu_si256((__m256i*)(_words + i), vop(a, b));
+        }
+#else
+        (void)vop;
+#endif
+        for (; i < n; i++) _words[i] = op(_words[i], other._words[i]);
+        _indexValid = false;
+    }
+
+public:
+    // 构造函数：预留 n 位
+    Bitmap(long long n = 64) { init(n); }
+
+    Bitmap(const Bitmap& b) {
+        init(64 * b._nWords);
+        memcpy(_words, b._words, sizeof(uint64_t) * _nWords);
+        _sz = b._sz;
+    }
+
+    Bitmap& operator=(const Bitmap& b) {
+        if (this == &b) return *this;
+        delete[] _words;
+        dropIndex();
+        init(64 * b._nWords);
+        memcpy(_words, b._words, sizeof(uint64_t) * _nWords);
+        _sz = b._sz;
+        return *this;
+    }
+
+    // 析构函数
+    ~Bitmap() {
+        delete[] _words;
+        dropIndex();
+    }
+
+    // 返回已使用的比特数（最高置位 + 1）
+    long long size() const { return _sz; }
+
+    // 当前容量（位）
+    long long capacity() const { return 64 * _nWords; }
+
+    // 预留至少 n 位，避免逐次扩容
+    void reserve(long long n) {
+        if (n > 0) expand(n - 1);
+    }
+
+    // 设置第 k 位为 1（超出容量时按两倍扩容）
+    void set(long long k) {
+        expand(k);
+        _words[k >> 6] |= 1ULL << (k & 63);
+        if (k + 1 > _sz) _sz = k + 1;
+        _indexValid = false;
+    }
+
+    // 清空第 k 位为 0
+    void clear(long long k) {
+        if (k >= 64 * _nWords) return;
+        _words[k >> 6] &= ~(1ULL << (k & 63));
+        if (k == _sz - 1) {
+            while (_sz > 0 && !test(_sz - 1)) _sz--;
+        }
+        _indexValid = false;
+    }
+
+    // 测试第 k 位是否为 1（超出范围返回 false）
+    bool test(long long k) const {
+        if (k >= 64 * _nWords) return false;
+        return (_words[k >> 6] >> (k & 63)) & 1;
+    }
+
+    // 全部清零（保留容量）
+    void reset() {
+        memset(_words, 0, sizeof(uint64_t) * _nWords);
+        _sz = 0;
+        _indexValid = false;
+    }
+
+    // 置位总数
+    long long count() const {
+        long long c = 0;
+        for (long long i = 0; i < _nWords; i++) c += popcount64(_words[i]);
+        return c;
+    }
+
+    // 第一个置位的位置，没有返回 -1
+    long long findFirst() const { return findNext(0); }
+
+    // 位置 >= k 的第一个置位，没有返回 -1。枚举：for (k = findFirst(); k >= 0; k = findNext(k + 1))
+    long long findNext(long long k) const {
+        if (k < 0) k = 0;
+        long long w = k >> 6;
+        if (w >= _nWords) return -1;
+        uint64_t cur = _words[w] & (~0ULL << (k & 63));
+        while (cur == 0) {
+            if (++w >= _nWords) return -1;
+            cur = _words[w];
+        }
+        return 64 * w + ctz64(cur);
+    }
+
+    // 批量运算：this = this op other（other 更长时先扩容）
+    void andWith(const Bitmap& other) {
+        // 超出 other 长度的部分与 0 相与
+        for (long long i = other._nWords; i < _nWords; i++) _words[i] = 0;
+        long long n = other._nWords < _nWords ? other._nWords : _nWords;
+        long long i = 0;
+#if defined(__AVX2__)
+        for (; i + 4 <= n; i += 4) {
+            __m256i a = _mm256_loadu_si256((const __m256i*)(_words + i));
+            __m256i b = _mm256_loadu_si256((const __m256i*)(other._words + i));
+            _mm256_storeu_si256((__m256i*)(_words + i), _mm256_and_si256(a, b));
+        }
+#endif
+        for (; i < n; i++) _words[i] &= other._words[i];
+        _indexValid = false;
+        recomputeSize();
+    }
+
+    void orWith(const Bitmap& other) {
+#if defined(__AVX2__)
+        combine(other, [](uint64_t a, uint64_t b) { return a | b; },
+                [](__m256i a, __m256i b) { return _mm256_or_si256(a, b); });
+#else
+        combine(other, [](uint64_t a, uint64_t b) { return a | b; }, 0);
+#endif
+        recomputeSize();
+    }
+
+    void xorWith(const Bitmap& other) {
+#if defined(__AVX2__)
+        combine(other, [](uint64_t a, uint64_t b) { return a ^ b; },
+                [](__m256i a, __m256i b) { return _mm256_xor_si256(a, b); });
+#else
+        combine(other, [](uint64_t a, uint64_t b) { return a ^ b; }, 0);
+#endif
+        recomputeSize();
+    }
+
+    // this = this & ~other
+    void andNotWith(const Bitmap& other) {
+        long long n = other._nWords < _nWords ? other._nWords : _nWords;
+        long long i = 0;
+#if defined(__AVX2__)
+        for (; i + 4 <= n; i += 4) {
+            __m256i a = _mm256_loadu_si256((const __m256i*)(_words + i));
+            __m256i b = _mm256_loadu_si256((const __m256i*)(other._words + i));
+            _mm256_storeu_si256((__m256i*)(_words + i), _mm256_andnot_si256(b, a));
+        }
+#endif
+        for (; i < n; i++) _words[i] &= ~other._words[i];
+        _indexValid = false;
+        recomputeSize();
+    }
+
+    // 建立 rank/select 索引（位图修改后需重新建立）
+    void buildRankIndex() {
+        dropIndex();
+        long long supers = (_nWords + 7) / 8 + 1;
+        _super = new uint64_t[supers];
+        _sub = new uint16_t[_nWords];
+        uint64_t total = 0;
+        for (long long w = 0; w < _nWords; w++) {
+            if ((w & 7) == 0) _super[w >> 3] = total;
+            _sub[w] = (uint16_t)(total - _super[w >> 3]);
+            total += popcount64(_words[w]);
+        }
+        _super[supers - 1] = total;
+        _indexValid = true;
+    }
+
+    // 前 k 位（[0, k)）中 1 的个数，O(1)
+    long long rank1(long long k) const {
+        if (!_indexValid) throw std::runtime_error("Bitmap rank index is stale");
+        if (k <= 0) return 0;
+        if (k >= 64 * _nWords) return (long long)_super[(_nWords + 7) / 8];
+        long long w = k >> 6;
+        uint64_t mask = (k & 63) ? (~0ULL >> (64 - (k & 63))) : 0;
+        return (long long)(_super[w >> 3] + _sub[w]) + popcount64(_words[w] & mask);
+    }
+
+    // 前 k 位中 0 的个数
+    long long rank0(long long k) const { return k - rank1(k); }
+
+    // 第 j 个 1（从 0 开始数）的位置，不存在返回 -1。二分超块后在至多 8 个字内定位
+    long long select1(long long j) const {
+        if (!_indexValid) throw std::runtime_error("Bitmap rank index is stale");
+        long long supers = (_nWords + 7) / 8;
+        if (j < 0 || (uint64_t)j >= _super[supers]) return -1;
+        long long lo = 0, hi = supers - 1; // 找最后一个 _super[s] <= j 的超块
+        while (lo < hi) {
+            long long mid = (lo + hi + 1) / 2;
+            if (_super[mid] <= (uint64_t)j) lo = mid;
+            else hi = mid - 1;
+        }
+        long long w = lo * 8;
+        long long last = w + 8 < _nWords ? w + 8 : _nWords;
+        while (w + 1 < last && _super[lo] + _sub[w + 1] <= (uint64_t)j) w++;
+        long long r = j - (long long)(_super[lo] + _sub[w]); // 在该字中是第 r 个 1
+        uint64_t x = _words[w];
+        for (long long i = 0; i < r; i++) x &= x - 1; // 清掉前 r 个 1
+        return 64 * w + ctz64(x);
+    }
+
+    // 底层字数组（供批量算法直接读写，写入后需自行维护 size / 索引）
+    uint64_t* words() const { return _words; }
+    long long wordCount() const { return _nWords; }
+
+    // 将前 n 位转换为字符串
+    char* bits2string(long long n) const {
+        char* s = new char[n + 1];
+        s[n] = '\0';
+        for (long long i = 0; i < n; i++) {
+            s[i] = test(i) ? '1' : '0';
+        }
+        return s;
+    }
+};
+
+#endif // BITMAP_H
@@ -0,0 +1,49 @@
+#ifndef CRC32_H
+#define CRC32_H
+#include <cstdint>
+#include <cstddef>
+
+// CRC-32（IEEE 802.3，反射多项式 0xEDB88320），slicing-by-8：每次查 8 张表处理 8 个字节
+class CRC32 {
+private:
+    uint32_t table[8][256];
+
+    CRC32() {
+        for (uint32_t i = 0; i < 256; i++) {
+            uint32_t c = i;
+            for (int k = 0; k < 8; k++) c = (c & 1) ? (c >> 1) ^ 0xEDB88320u : c >> 1;
+            table[0][i] = c;
+        }
+        for (int t = 1; t < 8; t++) {
+            for (int i = 0; i < 256; i++) {
+                table[t][i] = (table[t - 1][i] >> 8) ^ table[0][table[t - 1][i] & 0xFF];
+            }
+        }
+    }
+
+public:
+    static const CRC32& instance() {
+        static const CRC32 crc; // 首次使用时建表（线程安全）
+        return crc;
+    }
+
+    // 在已有校验值 crc 的基础上继续计算 [p, p + n)，初始传 0
+    uint32_t update(uint32_t crc, const void* data, size_t n) const {
+        const unsigned char* p = (const unsigned char*)data;
+        crc = ~crc;
+        for (; n >= 8; n -= 8, p += 8) {
+            uint32_t lo = crc ^ ((uint32_t)p[0] | (uint32_t)p[1] << 8 | (uint32_t)p[2] << 16 | (uint32_t)p[3] << 24);
+            crc = table[7][lo & 0xFF] ^ table[6][(lo >> 8) & 0xFF] ^
+                  table[5][(lo >> 16) & 0xFF] ^ table[4][lo >> 24] ^
+                  table[3][p[4]] ^ table[2][p[5]] ^ table[1][p[6]] ^ table[0][p[7]];
+        }
+        while (n--) crc = (crc >> 8) ^ table[0][(crc ^ *p++) & 0xFF];
+        return ~crc;
+    }
+};
+
+inline uint32_t crc32(const void* data, size_t n, uint32_t crc = 0) {
+    return CRC32::instance().update(crc, data, n);
+}
+
+#endif // CRC32_H
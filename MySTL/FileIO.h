@@ -0,0 +1,175 @@
+#ifndef FILEIO_H
+#define FILEIO_H
+#include <cstdio>
+#include <cstring>
+#include <cstddef>
+#ifdef _WIN32
+#include <fstream>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// 只读内存映射文件：POSIX 下用 mmap，其他平台退化为一次性读入内存
+class MappedFile {
+private:
+    const char* _data;
+    size_t _size;
+    bool _mapped; // true 表示 _data 来自 mmap，否则来自 new[]
+
+public:
+    MappedFile() : _data(nullptr), _size(0), _mapped(false) {}
+    ~MappedFile() { close(); }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    // 打开并映射文件，失败返回 false。sequential 为 false 时按随机访问提示内核（如图快照），
+    // 改为预读整个文件而不是顺序预读、读过即丢
+    bool open(const char* path, bool sequential = true) {
+        close();
+#ifdef _WIN32
+        (void)sequential;
+        std::ifstream in(path, std::ios::binary | std::ios::ate);
+        if (!in.is_open()) return false;
+        _size = (size_t)in.tellg();
+        char* buf = new char[_size + 1];
+        in.seekg(0);
+        in.read(buf, _size);
+        if (_size == 0) {
+            delete[] buf;
+            _data = "";
+            return true;
+        }
+        _data = buf;
+        _mapped = false;
+        return true;
+#else
+        int fd = ::open(path, O_RDONLY);
+        if (fd < 0) return false;
+        struct stat st;
+        if (fstat(fd, &st) != 0) {
+            ::close(fd);
+            return false;
+        }
+        _size = (size_t)st.st_size;
+        if (_size == 0) { // 空文件无法 mmap
+            ::close(fd);
+            _data = "";
+            _mapped = false;
+            return true;
+        }
+        void* p = mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (p == MAP_FAILED) {
+            _size = 0;
+            return false;
+        }
+        madvise(p, _size, sequential ? MADV_SEQUENTIAL : MADV_WILLNEED); // 提示内核预读方式
+        _data = (const char*)p;
+        _mapped = true;
+        return true;
+#endif
+    }
+
+    void close() {
+#ifndef _WIN32
+        if (_mapped) munmap((void*)_data, _size);
+#endif
+        if (!_mapped && _size > 0) delete[] _data;
+        _data = nullptr;
+        _size = 0;
+        _mapped = false;
+    }
+
+    const char* data() const { return _data; }
+    size_t size() const { return _size; }
+    bool isOpen() const { return _data != nullptr; }
+};
+
+// 带大缓冲区的顺序写出器：小块写入先攒在缓冲区，满了再一次性 fwrite。
+// 任何一次写出不完整或 fflush / fclose 失败（如磁盘已满）都会置上错误标志并一直保留，
+// 调用者最后检查 close() 的返回值即可知道整个文件是否完整写出
+class BufferedWriter {
+private:
+    FILE* _fp;
+    char* _buf;
+    size_t _cap;
+    size_t _len;
+    bool _owns;   // 是否由本对象负责关闭 _fp
+    bool _failed; // 出现过写错误
+
+    void writeOut(const char* p, size_t n) {
+        if (n > 0 && fwrite(p, 1, n, _fp) != n) _failed = true;
+    }
+
+public:
+    BufferedWriter(size_t cap = 1 << 20) : _fp(nullptr), _cap(cap), _len(0), _owns(false), _failed(false) {
+        _buf = new char[_cap];
+    }
+    ~BufferedWriter() {
+        close();
+        delete[] _buf;
+    }
+
+    BufferedWriter(const BufferedWriter&) = delete;
+    BufferedWriter& operator=(const BufferedWriter&) = delete;
+
+    // 打开输出文件（"-" 表示标准输出），失败返回 false
+    bool open(const char* path) {
+        close();
+        _failed = false;
+        if (strcmp(path, "-") == 0) {
+            _fp = stdout;
+            _owns = false;
+        } else {
+            _fp = fopen(path, "wb");
+            _owns = true;
+        }
+        return _fp != nullptr;
+    }
+
+    void write(const char* p, size_t n) {
+        if (_len + n > _cap) {
+            flush();
+            if (n >= _cap) { // 大块直接写出，不经过缓冲区
+                if (_fp) writeOut(p, n);
+                return;
+            }
+        }
+        memcpy(_buf + _len, p, n);
+        _len += n;
+    }
+
+    void put(char c) {
+        if (_len == _cap) flush();
+        _buf[_len++] = c;
+    }
+
+    void flush() {
+        if (_len > 0 && _fp) writeOut(_buf, _len);
+        _len = 0;
+    }
+
+    // 写出剩余数据并关闭文件，返回从 open 以来是否所有写入都成功
+    bool close() {
+        if (!_fp) {
+            _len = 0;
+            return !_failed;
+        }
+        flush();
+        if (fflush(_fp) != 0 || ferror(_fp)) _failed = true;
+        if (_owns && fclose(_fp) != 0) _failed = true;
+        _fp = nullptr;
+        return !_failed;
+    }
+
+    bool isOpen() const { return _fp != nullptr; }
+
+    // 是否已出现写错误
+    bool failed() const { return _failed; }
+};
+
+#endif // FILEIO_H
@@ -0,0 +1,57 @@
+#ifndef HISTOGRAM_H
+#define HISTOGRAM_H
+#include <cstdint>
+#include <cstring>
+#include <cstddef>
+#include "Parallel.h"
+
+// 字节直方图：结果累加到 freq[256]。
+// 相邻字节若相同，对同一计数器的“读-加-写”会串成依赖链；这里按位置轮流写 4 组子直方图，
+// 一次读入 8 字节拆开计数，最后再合并。子直方图用 uint32_t，每 1 GB 合并一次防止溢出
+inline void byteHistogram(const unsigned char* p, size_t n, uint64_t freq[256]) {
+    const size_t CHUNK = (size_t)1 << 30;
+    uint32_t c[4][256];
+    while (n > 0) {
+        size_t len = n < CHUNK ? n : CHUNK;
+        memset(c, 0, sizeof(c));
+        size_t i = 0;
+        for (; i + 16 <= len; i += 16) {
+            uint64_t a, b;
+            memcpy(&a, p + i, 8);
+            memcpy(&b, p + i + 8, 8);
+            c[0][a & 0xFF]++;         c[1][(a >> 8) & 0xFF]++;
+            c[2][(a >> 16) & 0xFF]++; c[3][(a >> 24) & 0xFF]++;
+            c[0][(a >> 32) & 0xFF]++; c[1][(a >> 40) & 0xFF]++;
+            c[2][(a >> 48) & 0xFF]++; c[3][a >> 56]++;
+            c[0][b & 0xFF]++;         c[1][(b >> 8) & 0xFF]++;
+            c[2][(b >> 16) & 0xFF]++; c[3][(b >> 24) & 0xFF]++;
+            c[0][(b >> 32) & 0xFF]++; c[1][(b >> 40) & 0xFF]++;
+            c[2][(b >> 48) & 0xFF]++; c[3][b >> 56]++;
+        }
+        for (; i < len; i++) c[0][p[i]]++;
+        for (int s = 0; s < 256; s++) freq[s] += (uint64_t)c[0][s] + c[1][s] + c[2][s] + c[3][s];
+        p += len;
+        n -= len;
+    }
+}
+
+// 多线程字节直方图：输入按线程切段，各线程独立计数后合并（适合 mmap 的大文件）
+inline void parallelByteHistogram(const unsigned char* p, size_t n, uint64_t freq[256], int threads = 0) {
+    const size_t MIN_PER_THREAD = 1 << 20; // 太小的输入不值得开线程
+    threads = resolveThreads(threads);
+    if ((size_t)threads > n / MIN_PER_THREAD) threads = (int)(n / MIN_PER_THREAD);
+    if (threads <= 1) {
+        byteHistogram(p, n, freq);
+        return;
+    }
+    uint64_t* local = new uint64_t[(size_t)threads * 256]();
+    parallelFor((long long)n, threads, [&](int t, long long lo, long long hi) {
+        byteHistogram(p + lo, (size_t)(hi - lo), local + (size_t)t * 256);
+    });
+    for (int t = 0; t < threads; t++) {
+        for (int s = 0; s < 256; s++) freq[s] += local[(size_t)t * 256 + s];
+    }
+    delete[] local;
+}
+
+#endif // HISTOGRAM_H
@@ -0,0 +1,148 @@
+#ifndef INDEXEDHEAP_H
+#define INDEXEDHEAP_H
+#include <stdexcept>
+
+// 索引 d 叉小根堆：元素是 [0, n) 内的编号，各带一个键值。
+// pos[id] 记录编号在堆数组中的位置，因此可以 O(log_d n) 地降低任意编号的键值（decreaseKey），
+// 适合 Dijkstra / Prim 这类“同一顶点的距离会被多次改小”的场合。
+// d 取 4 时树高减半，下沉时比较的 4 个孩子在同一缓存行内，通常比二叉堆快
+template <typename Key, int D = 4>
+class IndexedHeap {
+private:
+    int* _heap; // 堆数组，存编号
+    int* _pos;  // 编号 -> 堆中位置，-1 表示不在堆中
+    Key* _key;  // 编号 -> 键值
+    int _size;
+    int _n;     // 编号范围
+
+    void place(int i, int id) {
+        _heap[i] = id;
+        _pos[id] = i;
+    }
+
+    void siftUp(int i) {
+        int id = _heap[i];
+        Key k = _key[id];
+        while (i > 0) {
+            int parent = (i - 1) / D;
+            if (!(k < _key[_heap[parent]])) break;
+            place(i, _heap[parent]);
+            i = parent;
+        }
+        place(i, id);
+    }
+
+    void siftDown(int i) {
+        int id = _heap[i];
+        Key k = _key[id];
+        for (;;) {
+            int first = D * i + 1;
+            if (first >= _size) break;
+            int last = first + D < _size ? first + D : _size;
+            int best = first;
+            for (int c = first + 1; c < last; c++) {
+                if (_key[_heap[c]] < _key[_heap[best]]) best = c;
+            }
+            if (!(_key[_heap[best]] < k)) break;
+            place(i, _heap[best]);
+            i = best;
+        }
+        place(i, id);
+    }
+
+public:
+    // 编号范围 [0, n)
+    IndexedHeap(int n = 0) : _heap(nullptr), _pos(nullptr), _key(nullptr), _size(0), _n(0) { resize(n); }
+
+    ~IndexedHeap() {
+        delete[] _heap;
+        delete[] _pos;
+        delete[] _key;
+    }
+
+    IndexedHeap(const IndexedHeap&) = delete;
+    IndexedHeap& operator=(const IndexedHeap&) = delete;
+
+    // 重新设定编号范围并清空堆
+    void resize(int n) {
+        delete[] _heap;
+        delete[] _pos;
+        delete[] _key;
+        _n = n > 0 ? n : 0;
+        _heap = new int[_n > 0 ? _n : 1];
+        _pos = new int[_n > 0 ? _n : 1];
+        _key = new Key[_n > 0 ? _n : 1];
+        for (int i = 0; i < _n; i++) _pos[i] = -1;
+        _size = 0;
+    }
+
+    bool empty() const { return _size == 0; }
+    int size() const { return _size; }
+    int capacity() const { return _n; }
+
+    bool contains(int id) const { return _pos[id] >= 0; }
+
+    // 编号的当前键值（仅对在堆中或曾经入堆的编号有意义）
+    const Key& key(int id) const { return _key[id]; }
+
+    // 插入编号 id（调用者保证 id 不在堆中）
+    void push(int id, const Key& k) {
+        if (id < 0 || id >= _n) throw std::runtime_error("Heap index out of range");
+        if (contains(id)) throw std::runtime_error("Heap index already present");
+        _key[id] = k;
+        _heap[_size] = id;
+        _pos[id] = _size;
+        siftUp(_size++);
+    }
+
+    // 把 id 的键值降为 k（k 不小于当前值时不变）
+    void decreaseKey(int id, const Key& k) {
+        if (!contains(id)) throw std::runtime_error("Heap index not present");
+        if (!(k < _key[id])) return;
+        _key[id] = k;
+        siftUp(_pos[id]);
+    }
+
+    // 不在堆中则插入，否则尝试降低键值；返回键值是否被更新
+    bool pushOrDecrease(int id, const Key& k) {
+        if (!contains(id)) {
+            push(id, k);
+            return true;
+        }
+        if (!(k < _key[id])) return false;
+        _key[id] = k;
+        siftUp(_pos[id]);
+        return true;
+    }
+
+    // 键值最小的编号
+    int top() const {
+        if (empty()) throw std::runtime_error("Heap is empty");
+        return _heap[0];
+    }
+
+    const Key& topKey() const {
+        if (empty()) throw std::runtime_error("Heap is empty");
+        return _key[_heap[0]];
+    }
+
+    // 弹出并返回键值最小的编号
+    int pop() {
+        if (empty()) throw std::runtime_error("Heap is empty");
+        int id = _heap[0];
+        _pos[id] = -1;
+        if (--_size > 0) {
+            _heap[0] = _heap[_size];
+            siftDown(0);
+        }
+        return id;
+    }
+
+    // 清空（只重置仍在堆中的编号，O(size)）
+    void clear() {
+        for (int i = 0; i < _size; i++) _pos[_heap[i]] = -1;
+        _size = 0;
+    }
+};
+
+#endif // INDEXEDHEAP_H
@@ -0,0 +1,153 @@
+#ifndef PARALLEL_H
+#define PARALLEL_H
+#include <thread>
+#include <vector>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <exception>
+
+// 可用的硬件线程数（取不到时返回 1）
+inline int hardwareThreads() {
+    unsigned n = std::thread::hardware_concurrency();
+    return n == 0 ? 1 : (int)n;
+}
+
+// 规范化线程数：<= 0 表示使用全部硬件线程
+inline int resolveThreads(int threads) {
+    return threads <= 0 ? hardwareThreads() : threads;
+}
+
+// 启动 threads 个线程执行 fn(tid)，0 号任务在调用线程上执行，全部结束后返回。
+// 任一线程抛出的异常会在所有线程结束后于调用线程重新抛出（多个时只保留第一个）
+template <typename F>
+void parallelRun(int threads, F fn) {
+    threads = resolveThreads(threads);
+    std::exception_ptr error;
+    std::mutex errorLock;
+    auto guarded = [&](int t) {
+        try {
+            fn(t);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(errorLock);
+            if (!error) error = std::current_exception();
+        }
+    };
+    std::vector<std::thread> pool;
+    for (int t = 1; t < threads; t++) {
+        pool.emplace_back([&guarded, t]() { guarded(t); });
+    }
+    guarded(0);
+    for (auto& th : pool) th.join();
+    if (error) std::rethrow_exception(error);
+}
+
+// 把 [0, n) 均匀切成 threads 段并行执行 fn(tid, lo, hi)
+template <typename F>
+void parallelFor(long long n, int threads, F fn) {
+    threads = resolveThreads(threads);
+    if (n < threads) threads = n > 0 ? (int)n : 1;
+    parallelRun(threads, [&](int t) {
+        long long lo = n * t / threads;
+        long long hi = n * (t + 1) / threads;
+        if (lo < hi) fn(t, lo, hi);
+    });
+}
+
+// 常驻线程池（fork-join）：run(tasks, fn) 把任务号 [0, tasks) 分给所有线程（含调用线程）
+// 动态领取执行 fn(task, worker)，全部完成后返回。适合多轮短任务，避免每轮重新创建线程。
+// 任务抛出异常时不再分发剩余任务，等所有线程停下后在调用线程重新抛出第一个异常
+class ThreadPool {
+private:
+    std::vector<std::thread> workers;
+    std::mutex m;
+    std::condition_variable startCv, doneCv;
+    std::function<void(int, int)> job;
+    std::atomic<int> nextTask;
+    int taskCount;
+    int active;          // 本轮尚未完成的后台线程数
+    unsigned generation; // 轮次编号，后台线程据此发现新任务
+    bool stop;
+    std::exception_ptr error; // 本轮第一个任务异常，受 m 保护
+
+    void work(int worker) {
+        for (;;) {
+            int t;
+            while ((t = nextTask.fetch_add(1)) < taskCount) {
+                try {
+                    job(t, worker);
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock(m);
+                    if (!error) error = std::current_exception();
+                    nextTask = taskCount; // 其余任务不再领取
+                }
+            }
+            if (worker == 0) return; // 调用线程不进入等待循环
+            std::unique_lock<std::mutex> lock(m);
+            if (--active == 0) doneCv.notify_one();
+            unsigned seen = generation;
+            startCv.wait(lock, [&] { return stop || generation != seen; });
+            if (stop) return;
+        }
+    }
+
+public:
+    // threads：总线程数（含调用线程），<= 0 表示全部硬件线程
+    ThreadPool(int threads = 0) : nextTask(0), taskCount(0), active(0), generation(0), stop(false) {
+        threads = resolveThreads(threads);
+        for (int w = 1; w < threads; w++) {
+            workers.emplace_back([this, w] {
+                std::unique_lock<std::mutex> lock(m);
+                startCv.wait(lock, [&] { return stop || generation != 0; });
+                if (stop) return;
+                lock.unlock();
+                work(w);
+            });
+        }
+    }
+
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(m);
+            stop = true;
+        }
+        startCv.notify_all();
+        for (auto& th : workers) th.join();
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    int size() const { return (int)workers.size() + 1; }
+
+    template <typename F>
+    void run(int tasks, F fn) {
+        if (tasks <= 0) return;
+        if (workers.empty() || tasks == 1) {
+            for (int t = 0; t < tasks; t++) fn(t, 0);
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lock(m);
+            job = fn;
+            taskCount = tasks;
+            nextTask = 0;
+            active = (int)workers.size();
+            error = nullptr;
+            generation++;
+        }
+        startCv.notify_all();
+        work(0);
+        std::exception_ptr failed;
+        {
+            std::unique_lock<std::mutex> lock(m);
+            doneCv.wait(lock, [&] { return active == 0; });
+            failed = error;
+            error = nullptr;
+        }
+        if (failed) std::rethrow_exception(failed);
+    }
+};
+
+#endif // PARALLEL_H
@@ -0,0 +1,203 @@
+#ifndef RANDOM_H
+#define RANDOM_H
+#include <cstdint>
+#include <cstring>
+#include "Parallel.h"
+
+// 默认随机种子：同一种子在任何线程数下都生成同样的数据，便于复现实验
+const uint64_t DEFAULT_SEED = 20250101;
+
+// 每个随机流负责的连续元素个数。块 b 使用主流跳跃 b 次后的子流，
+// 因此结果只与种子有关，与线程数无关
+const long long RANDOM_BLOCK = 1 << 16;
+
+// SplitMix64：把任意 64 位种子扩散成 xoshiro 的初始状态
+inline uint64_t splitmix64(uint64_t& x) {
+    uint64_t z = (x += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+// xoshiro256** 伪随机数发生器：周期 2^256 - 1，每次只需几次移位/异或，
+// jump() 前进 2^128 步，用来切出互不重叠的并行子流
+class Xoshiro256 {
+private:
+    uint64_t s[4];
+
+    static uint64_t rotl(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+
+public:
+    Xoshiro256(uint64_t seed = DEFAULT_SEED) { this->seed(seed); }
+
+    void seed(uint64_t seed) {
+        for (int i = 0; i < 4; i++) s[i] = splitmix64(seed);
+    }
+
+    // 下一个 64 位随机数
+    uint64_t next() {
+        uint64_t result = rotl(s[1] * 5, 7) * 9;
+        uint64_t t = s[1] << 17;
+        s[2] ^= s[0];
+        s[3] ^= s[1];
+        s[1] ^= s[2];
+        s[0] ^= s[3];
+        s[2] ^= t;
+        s[3] = rotl(s[3], 45);
+        return result;
+    }
+
+    // [0, 1) 上均匀分布的 double（取高 53 位）
+    double nextDouble() { return (next() >> 11) * 0x1.0p-53; }
+
+    // [0, bound) 上无偏的均匀整数（Lemire 乘法取高位 + 拒绝采样）。
+    // bound == 0 视为 2^64，即整个 64 位范围
+    uint64_t nextBelow(uint64_t bound) {
+        if (bound == 0) return next();
+#ifdef __SIZEOF_INT128__
+        __uint128_t m = (__uint128_t)next() * bound;
+        uint64_t low = (uint64_t)m;
+        if (low < bound) {
+            uint64_t threshold = (0 - bound) % bound;
+            while (low < threshold) {
+                m = (__uint128_t)next() * bound;
+                low = (uint64_t)m;
+            }
+        }
+        return (uint64_t)(m >> 64);
+#else
+        uint64_t threshold = (0 - bound) % bound;
+        uint64_t r;
+        do { r = next(); } while (r < threshold);
+        return r % bound;
+#endif
+    }
+
+    // [lo, hi] 上的均匀整数。差值按无符号数计算，nextInt(LLONG_MIN, LLONG_MAX) 也不会溢出
+    long long nextInt(long long lo, long long hi) {
+        return (long long)((uint64_t)lo + nextBelow((uint64_t)hi - (uint64_t)lo + 1));
+    }
+
+    // 前进 2^128 步：连续调用可得到 2^128 个互不重叠的子流
+    void jump() {
+        static const uint64_t JUMP[] = {0x180ec6d33cfd0abaULL, 0xd5a61266f0c9392cULL,
+                                        0xa9582618e03fc9aaULL, 0x39abdc4529b1661cULL};
+        uint64_t t[4] = {0, 0, 0, 0};
+        for (int i = 0; i < 4; i++) {
+            for (int b = 0; b < 64; b++) {
+                if (JUMP[i] & (1ULL << b)) {
+                    for (int k = 0; k < 4; k++) t[k] ^= s[k];
+                }
+                next();
+            }
+        }
+        memcpy(s, t, sizeof(s));
+    }
+};
+
+// 并行生成：a[i] = gen(rng)，按 RANDOM_BLOCK 分块，块 b 使用第 b 个子流
+template <typename T, typename Gen>
+void parallelGenerate(T* a, long long n, uint64_t seed, int threads, Gen gen) {
+    long long blocks = (n + RANDOM_BLOCK - 1) / RANDOM_BLOCK;
+    parallelFor(blocks, threads, [&](int, long long bLo, long long bHi) {
+        Xoshiro256 rng(seed);
+        for (long long b = 0; b < bLo; b++) rng.jump();
+        for (long long b = bLo; b < bHi; b++) {
+            Xoshiro256 local = rng;
+            long long hi = (b + 1) * RANDOM_BLOCK < n ? (b + 1) * RANDOM_BLOCK : n;
+            for (long long i = b * RANDOM_BLOCK; i < hi; i++) a[i] = gen(local);
+            rng.jump();
+        }
+    });
+}
+
+// 并行填充 [lo, hi] 上的均匀整数
+template <typename T>
+void parallelFillInt(T* a, long long n, long long lo, long long hi,
+                     uint64_t seed = DEFAULT_SEED, int threads = 0) {
+    parallelGenerate(a, n, seed, threads, [lo, hi](Xoshiro256& rng) { return (T)rng.nextInt(lo, hi); });
+}
+
+// 并行填充 [lo, hi) 上的均匀实数
+inline void parallelFillDouble(double* a, long long n, double lo, double hi,
+                               uint64_t seed = DEFAULT_SEED, int threads = 0) {
+    parallelGenerate(a, n, seed, threads, [lo, hi](Xoshiro256& rng) { return lo + (hi - lo) * rng.nextDouble(); });
+}
+
+// 串行 Fisher–Yates 置乱
+template <typename T>
+void shuffle(T* a, long long n, Xoshiro256& rng) {
+    for (long long i = n - 1; i > 0; i--) {
+        long long j = (long long)rng.nextBelow((uint64_t)i + 1);
+        T tmp = a[i];
+        a[i] = a[j];
+        a[j] = tmp;
+    }
+}
+
+// 并行置乱：
+//   1. 每个元素独立均匀地随机分到 K 个桶之一（各块用自己的子流），统计每块每桶的个数；
+//   2. 前缀和确定位置后把元素分散写入临时数组；
+//   3. 各桶内部并行做 Fisher–Yates。
+// 桶大小服从多项分布、桶内排列均匀，拼接后得到的仍是均匀随机排列
+template <typename T>
+void parallelShuffle(T* a, long long n, uint64_t seed = DEFAULT_SEED, int threads = 0) {
+    const int K = 256;
+    if (n < 4 * RANDOM_BLOCK) { // 小数组直接串行
+        Xoshiro256 rng(seed);
+        shuffle(a, n, rng);
+        return;
+    }
+    long long blocks = (n + RANDOM_BLOCK - 1) / RANDOM_BLOCK;
+    unsigned char* bucket = new unsigned char[n];
+    long long* offset = new long long[blocks * K](); // offset[b * K + k]：块 b 中桶 k 的元素个数 / 起始位置
+
+    // 1. 分桶并计数
+    parallelGenerate(bucket, n, seed, threads, [](Xoshiro256& rng) { return (unsigned char)(rng.next() >> 56); });
+    parallelFor(blocks, threads, [&](int, long long bLo, long long bHi) {
+        for (long long b = bLo; b < bHi; b++) {
+            long long hi = (b + 1) * RANDOM_BLOCK < n ? (b + 1) * RANDOM_BLOCK : n;
+            for (long long i = b * RANDOM_BLOCK; i < hi; i++) offset[b * K + bucket[i]]++;
+        }
+    });
+
+    // 2. 按（桶，块）顺序求前缀和，然后分散写入
+    long long* bucketStart = new long long[K + 1];
+    long long sum = 0;
+    for (int k = 0; k < K; k++) {
+        bucketStart[k] = sum;
+        for (long long b = 0; b < blocks; b++) {
+            long long c = offset[b * K + k];
+            offset[b * K + k] = sum;
+            sum += c;
+        }
+    }
+    bucketStart[K] = n;
+    T* tmp = new T[n];
+    parallelFor(blocks, threads, [&](int, long long bLo, long long bHi) {
+        for (long long b = bLo; b < bHi; b++) {
+            long long hi = (b + 1) * RANDOM_BLOCK < n ? (b + 1) * RANDOM_BLOCK : n;
+            for (long long i = b * RANDOM_BLOCK; i < hi; i++) tmp[offset[b * K + bucket[i]]++] = a[i];
+        }
+    });
+
+    // 3. 桶内置乱（桶 k 使用种子派生的第 k 个子流），结果写回 a
+    parallelFor(K, threads, [&](int, long long kLo, long long kHi) {
+        Xoshiro256 rng(seed ^ 0x5DEECE66DULL);
+        for (long long k = 0; k < kLo; k++) rng.jump();
+        for (long long k = kLo; k < kHi; k++) {
+            long long lo = bucketStart[k], len = bucketStart[k + 1] - lo;
+            Xoshiro256 local = rng;
+            shuffle(tmp + lo, len, local);
+            for (long long i = 0; i < len; i++) a[lo + i] = tmp[lo + i];
+            rng.jump();
+        }
+    });
+
+    delete[] tmp;
+    delete[] bucketStart;
+    delete[] offset;
+    delete[] bucket;
+}
+
+#endif // RANDOM_H
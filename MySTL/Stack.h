@@ -57,6 +57,65 @@ public:
     }
 };
 
-#endif // STACK_H
-#endif // STACK_H
+// 基于连续数组的栈：push/pop 不再逐个 new/delete 结点，clear() 保留容量，
+// 适合在循环中反复复用（如每个线程一个求值栈）
+template <typename T>
+class ArrayStack {
+private:
+    T* _elem;
+    int _size;
+    int _cap;
+
+    void expand() {
+        if (_size < _cap) return;
+        reserve(_cap < 8 ? 16 : _cap * 2);
+    }
+
+public:
+    ArrayStack(int c = 16) : _elem(nullptr), _size(0), _cap(0) { reserve(c); }
+
+    ~ArrayStack() { delete[] _elem; }
+
+    ArrayStack(const ArrayStack&) = delete;
+    ArrayStack& operator=(const ArrayStack&) = delete;
+
+    // 预留至少 c 个元素的空间
+    void reserve(int c) {
+        if (c <= _cap) return;
+        T* newElem = new T[c];
+        for (int i = 0; i < _size; i++) newElem[i] = _elem[i];
+        delete[] _elem;
+        _elem = newElem;
+        _cap = c;
+    }
+
+    void push(const T& val) {
+        expand();
+        _elem[_size++] = val;
+    }
+
+    T pop() {
+        if (empty()) {
+            throw std::runtime_error("Stack is empty");
+        }
+        return _elem[--_size];
+    }
 
+    T top() const {
+        if (empty()) {
+            throw std::runtime_error("Stack is empty");
+        }
+        return _elem[_size - 1];
+    }
+
+    // 栈顶以下第 k 个元素（k = 0 即栈顶），调用者保证 k < size()
+    const T& peek(int k) const { return _elem[_size - 1 - k]; }
+
+    bool empty() const { return _size == 0; }
+
+    int size() const { return _size; }
+
+    void clear() { _size = 0; }
+};
+
+#endif // STACK_H
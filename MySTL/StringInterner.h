@@ -0,0 +1,163 @@
+#ifndef STRINGINTERNER_H
+#define STRINGINTERNER_H
+#include <cstdint>
+#include <cstring>
+#include <cstddef>
+#include <stdexcept>
+#include <string_view>
+
+// 字符串驻留表：把名字映射成稠密编号 0, 1, 2, ...（按首次加入的顺序）。
+// 所有名字首尾相接存放在一块连续的字符区里，编号 i 的名字为 _arena[_start[i], _start[i + 1])；
+// 查找用开放定址（线性探测）哈希表，槽里只存编号，负载因子不超过 1/2，
+// 每个编号缓存自己的哈希值，比较时先比哈希再比字节，扩容时无需重新计算哈希
+class StringInterner {
+private:
+    char* _arena;       // 连续字符区
+    size_t _arenaSize;
+    size_t _arenaCap;
+    size_t* _start;     // 编号 -> 名字在字符区中的起点，共 _count + 1 项
+    uint64_t* _hash;    // 编号 -> 哈希值
+    int _count;
+    int _idCap;
+    int* _slots;        // 哈希表，-1 表示空槽
+    size_t _mask;       // 槽数 - 1（槽数为 2 的幂）
+
+    // FNV-1a，末尾再做一次混合，使低位也足够均匀（槽号取低位）
+    static uint64_t hashOf(std::string_view s) {
+        uint64_t h = 0xcbf29ce484222325ULL;
+        for (unsigned char c : s) {
+            h ^= c;
+            h *= 0x100000001b3ULL;
+        }
+        h ^= h >> 32;
+        h *= 0xd6e8feb86659fd93ULL;
+        return h ^ (h >> 32);
+    }
+
+    std::string_view view(int id) const {
+        return std::string_view(_arena + _start[id], _start[id + 1] - _start[id]);
+    }
+
+    // 名字 s（哈希值 h）所在的槽；不存在时返回应插入的空槽
+    size_t probe(std::string_view s, uint64_t h) const {
+        size_t i = (size_t)h & _mask;
+        for (;;) {
+            int id = _slots[i];
+            if (id < 0) return i;
+            if (_hash[id] == h && view(id) == s) return i;
+            i = (i + 1) & _mask;
+        }
+    }
+
+    void growSlots() {
+        size_t n = (_mask + 1) * 2;
+        delete[] _slots;
+        _slots = new int[n];
+        for (size_t i = 0; i < n; i++) _slots[i] = -1;
+        _mask = n - 1;
+        for (int id = 0; id < _count; id++) {
+            size_t i = (size_t)_hash[id] & _mask;
+            while (_slots[i] >= 0) i = (i + 1) & _mask;
+            _slots[i] = id;
+        }
+    }
+
+    void growIds(int need) {
+        int cap = _idCap * 2 > need ? _idCap * 2 : need;
+        size_t* start = new size_t[(size_t)cap + 1];
+        uint64_t* hash = new uint64_t[cap];
+        memcpy(start, _start, sizeof(size_t) * ((size_t)_count + 1));
+        memcpy(hash, _hash, sizeof(uint64_t) * _count);
+        delete[] _start;
+        delete[] _hash;
+        _start = start;
+        _hash = hash;
+        _idCap = cap;
+    }
+
+    void growArena(size_t need) {
+        size_t cap = _arenaCap * 2 > need ? _arenaCap * 2 : need;
+        char* arena = new char[cap];
+        memcpy(arena, _arena, _arenaSize);
+        delete[] _arena;
+        _arena = arena;
+        _arenaCap = cap;
+    }
+
+public:
+    static const int NOT_FOUND = -1;
+
+    StringInterner() : _arenaSize(0), _arenaCap(64), _count(0), _idCap(8), _mask(15) {
+        _arena = new char[_arenaCap];
+        _start = new size_t[_idCap + 1];
+        _start[0] = 0;
+        _hash = new uint64_t[_idCap];
+        _slots = new int[_mask + 1];
+        for (size_t i = 0; i <= _mask; i++) _slots[i] = -1;
+    }
+
+    ~StringInterner() {
+        delete[] _arena;
+        delete[] _start;
+        delete[] _hash;
+        delete[] _slots;
+    }
+
+    StringInterner(const StringInterner&) = delete;
+    StringInterner& operator=(const StringInterner&) = delete;
+
+    // 预留 n 个名字、共 bytes 字节的空间，批量加入前调用可避免逐次扩容
+    void reserve(int n, size_t bytes = 0) {
+        if (n > _idCap) growIds(n);
+        while ((size_t)n * 2 > _mask + 1) growSlots();
+        if (bytes > _arenaCap) growArena(bytes);
+    }
+
+    // 返回名字的编号，不存在时加入并分配下一个编号
+    int intern(std::string_view s) {
+        uint64_t h = hashOf(s);
+        size_t i = probe(s, h);
+        if (_slots[i] >= 0) return _slots[i];
+        if (_count == INT32_MAX) throw std::runtime_error("Too many interned strings");
+        if (_count + 1 > _idCap) growIds(_count + 1);
+        if (_arenaSize + s.size() > _arenaCap) growArena(_arenaSize + s.size());
+        memcpy(_arena + _arenaSize, s.data(), s.size());
+        _arenaSize += s.size();
+        int id = _count++;
+        _start[_count] = _arenaSize;
+        _hash[id] = h;
+        _slots[i] = id;
+        if ((size_t)_count * 2 > _mask + 1) growSlots();
+        return id;
+    }
+
+    // 查找名字的编号，不存在返回 NOT_FOUND（不会插入）
+    int find(std::string_view s) const {
+        return _slots[probe(s, hashOf(s))];
+    }
+
+    bool contains(std::string_view s) const { return find(s) != NOT_FOUND; }
+
+    // 编号对应的名字。返回的视图指向字符区，之后再加入名字可能使字符区搬家而失效
+    std::string_view name(int id) const {
+        if (id < 0 || id >= _count) throw std::runtime_error("String id out of range");
+        return view(id);
+    }
+
+    int size() const { return _count; }
+    bool empty() const { return _count == 0; }
+
+    // 清空（保留已分配的空间）
+    void clear() {
+        for (size_t i = 0; i <= _mask; i++) _slots[i] = -1;
+        _count = 0;
+        _arenaSize = 0;
+    }
+
+    // 占用的字节数
+    size_t memoryBytes() const {
+        return _arenaCap + sizeof(size_t) * ((size_t)_idCap + 1) + sizeof(uint64_t) * _idCap + sizeof(int) * (_mask + 1);
+    }
+};
+
+#endif // STRINGINTERNER_H
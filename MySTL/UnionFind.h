@@ -0,0 +1,76 @@
+#ifndef UNIONFIND_H
+#define UNIONFIND_H
+
+// 并查集（不相交集合森林）：按秩合并 + 路径压缩，单次操作均摊 O(α(n))。
+// 元素为 [0, n) 内的编号，每个集合以树根为代表
+class UnionFind {
+private:
+    int* _parent;
+    unsigned char* _rank; // 树高上界，按秩合并时树高不超过 log2(n)
+    int _n;
+    int _sets;            // 当前集合个数
+
+public:
+    UnionFind(int n = 0) : _parent(nullptr), _rank(nullptr), _n(0), _sets(0) { reset(n); }
+
+    ~UnionFind() {
+        delete[] _parent;
+        delete[] _rank;
+    }
+
+    UnionFind(const UnionFind&) = delete;
+    UnionFind& operator=(const UnionFind&) = delete;
+
+    // 重新初始化为 n 个单元素集合
+    void reset(int n) {
+        if (n != _n) {
+            delete[] _parent;
+            delete[] _rank;
+            _n = n > 0 ? n : 0;
+            _parent = new int[_n > 0 ? _n : 1];
+            _rank = new unsigned char[_n > 0 ? _n : 1];
+        }
+        for (int i = 0; i < _n; i++) {
+            _parent[i] = i;
+            _rank[i] = 0;
+        }
+        _sets = _n;
+    }
+
+    // 所在集合的代表元：先找到根，再把路径上的节点都直接挂到根上（迭代，无递归）
+    int find(int x) {
+        int root = x;
+        while (_parent[root] != root) root = _parent[root];
+        while (_parent[x] != root) {
+            int next = _parent[x];
+            _parent[x] = root;
+            x = next;
+        }
+        return root;
+    }
+
+    // 合并 a、b 所在的集合，原本已在同一集合时返回 false
+    bool unite(int a, int b) {
+        a = find(a);
+        b = find(b);
+        if (a == b) return false;
+        if (_rank[a] < _rank[b]) {
+            int t = a;
+            a = b;
+            b = t;
+        }
+        _parent[b] = a;
+        if (_rank[a] == _rank[b]) _rank[a]++;
+        _sets--;
+        return true;
+    }
+
+    bool connected(int a, int b) { return find(a) == find(b); }
+
+    int size() const { return _n; }
+
+    // 集合个数
+    int count() const { return _sets; }
+};
+
+#endif // UNIONFIND_H
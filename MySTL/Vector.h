@@ -3,6 +3,7 @@
 #include <iostream>
 #include <cstdlib>
 #include <cstring>
+#include <initializer_list>
 #include <algorithm> // 用于 std::max（兼容不同编译器）
 using namespace std;
 
@@ -65,6 +66,14 @@ public:
         }
     }
 
+    // 列表初始化：Vector<int> v = {1, 2, 3};
+    Vector(initializer_list<T> il) : _capacity(max((Rank)il.size(), DEFAULT_CAPACITY)), _size(0) {
+        _elem = new T[_capacity];
+        for (const T& e : il) {
+            _elem[_size++] = e;
+        }
+    }
+
     // 拷贝构造：从另一个 Vector 复制
     Vector(const Vector<T>& V) : _capacity(V._capacity), _size(V._size) {
         _elem = new T[_capacity];
@@ -211,6 +220,27 @@ public:
         return old;
     }
 
+    // 调整元素个数为 n：变大时按需扩容，新增位置为默认值；变小时只修改 size
+    void resize(Rank n) {
+        if (n > _capacity) {
+            T* oldElem = _elem;
+            _capacity = max(n, DEFAULT_CAPACITY);
+            _elem = new T[_capacity];
+            for (Rank i = 0; i < _size; i++) {
+                _elem[i] = oldElem[i];
+            }
+            delete[] oldElem;
+        }
+        for (Rank i = _size; i < n; i++) {
+            _elem[i] = T();
+        }
+        _size = max(n, 0);
+    }
+
+    // 底层连续存储的首地址（供批量算法直接读写）
+    T* data() { return _elem; }
+    const T* data() const { return _elem; }
+
     // 清空所有元素（O(1)，仅修改 size，不释放内存）
     void clear() {
         _size = 0;
@@ -1,9 +1,16 @@
 #include <iostream>
 #include <cmath>
 #include <cstdlib>
-#include <ctime>
 #include <string>
+#include <cstdint>
+#include <algorithm>
+#include <cstring>
+#include <chrono>
 #include "MySTL/Vector.h"
+#include "MySTL/Random.h"
+#if defined(__AVX__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
 
 using namespace std;
 
@@ -24,6 +31,9 @@ public:
 
     double modulus() const { return sqrt(real * real + imag * imag); }
 
+    // 模的平方：与 modulus() 同序，比较大小时用它可以省掉 sqrt
+    double squaredModulus() const { return real * real + imag * imag; }
+
     bool operator==(const Complex& other) const {
         return (real == other.real) && (imag == other.imag);
     }
@@ -34,25 +44,22 @@ public:
     }
 };
 
-// 生成随机复数向量
-Vector<Complex> generateRandomComplexVector(int size, double minVal, double maxVal) {
-    Vector<Complex> vec;
-    srand(time(0));
-    for (int i = 0; i < size; ++i) {
-        double real = minVal + (maxVal - minVal) * rand() / RAND_MAX;
-        double imag = minVal + (maxVal - minVal) * rand() / RAND_MAX;
-        vec.push_back(Complex(real, imag));
-    }
+// 生成随机复数向量（给定种子时结果可复现，大规模数据多线程生成）
+Vector<Complex> generateRandomComplexVector(int size, double minVal, double maxVal,
+                                            uint64_t seed = DEFAULT_SEED) {
+    Vector<Complex> vec(max(size, 1));
+    vec.resize(size);
+    parallelGenerate(vec.data(), size, seed, 0, [minVal, maxVal](Xoshiro256& rng) {
+        double real = minVal + (maxVal - minVal) * rng.nextDouble();
+        double imag = minVal + (maxVal - minVal) * rng.nextDouble();
+        return Complex(real, imag);
+    });
     return vec;
 }
 
 // 向量置乱
-void shuffleVector(Vector<Complex>& vec) {
-    srand(time(0));
-    for (int i = vec.size() - 1; i > 0; --i) {
-        int j = rand() % (i + 1);
-        swap(vec[i], vec[j]);
-    }
+void shuffleVector(Vector<Complex>& vec, uint64_t seed = DEFAULT_SEED) {
+    parallelShuffle(vec.data(), vec.size(), seed);
 }
 
 // 向量唯一化
@@ -78,8 +85,8 @@ void bubbleSort(Vector<Complex>& vec) {
     int n = vec.size();
     for (int i = 0; i < n - 1; ++i) {
         for (int j = 0; j < n - i - 1; ++j) {
-            double modJ = vec[j].modulus();
-            double modJ1 = vec[j + 1].modulus();
+            double modJ = vec[j].squaredModulus();
+            double modJ1 = vec[j + 1].squaredModulus();
             if (modJ > modJ1 || (modJ == modJ1 && vec[j].getReal() > vec[j + 1].getReal())) {
                 swap(vec[j], vec[j + 1]);
             }
@@ -100,8 +107,8 @@ void merge(Vector<Complex>& vec, int left, int mid, int right) {
 
     int i = 0, j = 0, k = left;
     while (i < n1 && j < n2) {
-        double modL = L[i].modulus();
-        double modR = R[j].modulus();
+        double modL = L[i].squaredModulus();
+        double modR = R[j].squaredModulus();
         if (modL < modR || (modL == modR && L[i].getReal() <= R[j].getReal())) {
             vec[k] = L[i];
             i++;
@@ -135,18 +142,312 @@ void mergeSort(Vector<Complex>& vec, int left, int right) {
     }
 }
 
-// 区间查找（模介于[m1, m2)的元素）
+// 秩区间 [lo, hi)：有序向量上查询结果的非拥有视图，不复制元素
+struct RankRange {
+    Rank lo;
+    Rank hi;
+    Rank size() const { return hi - lo; }
+    bool empty() const { return hi <= lo; }
+};
+
+// 模的平方阈值：返回最小的 t，使得对任意非负 k 有 sqrt(k) >= m 当且仅当 k >= t。
+// 每次查询只在这里调用常数次 sqrt，二分过程中直接比较平方，结果与逐个比较 modulus() 完全一致。
+double squaredThreshold(double m) {
+    if (!(m > 0)) return 0.0; // m <= 0：所有元素都满足
+    double t = m * m;
+    while (sqrt(t) < m) t = nextafter(t, HUGE_VAL);
+    while (t > 0 && sqrt(nextafter(t, 0.0)) >= m) t = nextafter(t, 0.0);
+    return t;
+}
+
+// 在按模升序的向量中找第一个模 >= m 的秩（O(log n)）
+Rank modulusLowerBound(const Vector<Complex>& sortedVec, double m) {
+    double t = squaredThreshold(m);
+    Rank lo = 0, hi = sortedVec.size();
+    while (lo < hi) {
+        Rank mid = lo + (hi - lo) / 2;
+        if (sortedVec[mid].squaredModulus() < t) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo;
+}
+
+// 在按模升序的向量中找第一个模 > m 的秩（O(log n)）
+Rank modulusUpperBound(const Vector<Complex>& sortedVec, double m) {
+    return modulusLowerBound(sortedVec, nextafter(m, HUGE_VAL));
+}
+
+// 模介于 [m1, m2) 的元素所在秩区间（两次二分，不复制元素）
+RankRange modulusRange(const Vector<Complex>& sortedVec, double m1, double m2) {
+    Rank lo = modulusLowerBound(sortedVec, m1);
+    Rank hi = max(lo, modulusLowerBound(sortedVec, m2));
+    return {lo, hi};
+}
+
+// 区间查找（模介于[m1, m2)的元素）：二分定位后只复制命中的元素
 Vector<Complex> rangeSearch(const Vector<Complex>& sortedVec, double m1, double m2) {
     Vector<Complex> result;
-    for (int i = 0; i < sortedVec.size(); ++i) {
-        double mod = sortedVec[i].modulus();
-        if (mod >= m1 && mod < m2) {
-            result.push_back(sortedVec[i]);
-        }
+    RankRange r = modulusRange(sortedVec, m1, m2);
+    for (int i = r.lo; i < r.hi; ++i) {
+        result.push_back(sortedVec[i]);
     }
     return result;
 }
 
+// 结构体数组（SoA）形式的复数向量：实部、虚部、排序键（模的平方）各占一个连续数组。
+// 键由 computeKeys() 批量 SIMD 计算，排序只比较缓存的键（相同时比较实部），全程不调用 sqrt。
+class ComplexVector {
+private:
+    double* re;
+    double* im;
+    double* key;
+    int _size;
+    int _cap;
+
+    void reserve(int c) {
+        if (c <= _cap) return;
+        double* nre = new double[c];
+        double* nim = new double[c];
+        double* nkey = new double[c];
+        memcpy(nre, re, sizeof(double) * _size);
+        memcpy(nim, im, sizeof(double) * _size);
+        memcpy(nkey, key, sizeof(double) * _size);
+        delete[] re;
+        delete[] im;
+        delete[] key;
+        re = nre;
+        im = nim;
+        key = nkey;
+        _cap = c;
+    }
+
+    // 键相同比实部
+    bool lessAt(int i, int j) const {
+        return key[i] < key[j] || (key[i] == key[j] && re[i] < re[j]);
+    }
+
+    // 小区间插入排序（同时移动三列）
+    void insertionSort(int lo, int hi) {
+        for (int i = lo + 1; i < hi; i++) {
+            double k = key[i], r = re[i], m = im[i];
+            int j = i - 1;
+            while (j >= lo && (key[j] > k || (key[j] == k && re[j] > r))) {
+                key[j + 1] = key[j];
+                re[j + 1] = re[j];
+                im[j + 1] = im[j];
+                j--;
+            }
+            key[j + 1] = k;
+            re[j + 1] = r;
+            im[j + 1] = m;
+        }
+    }
+
+    // 键相同的区段 [lo, hi) 按实部稳定排序（键不变，只需移动实部和虚部）
+    void sortRunByReal(int lo, int hi) {
+        struct Part {
+            double re, im;
+        };
+        int n = hi - lo;
+        Part* run = new Part[n];
+        for (int i = 0; i < n; i++) run[i] = {re[lo + i], im[lo + i]};
+        stable_sort(run, run + n, [](const Part& a, const Part& b) { return a.re < b.re; });
+        for (int i = 0; i < n; i++) {
+            re[lo + i] = run[i].re;
+            im[lo + i] = run[i].im;
+        }
+        delete[] run;
+    }
+
+public:
+    ComplexVector(int cap = 16) : re(nullptr), im(nullptr), key(nullptr), _size(0), _cap(0) {
+        reserve(max(cap, 1));
+    }
+
+    ComplexVector(const Vector<Complex>& vec) : re(nullptr), im(nullptr), key(nullptr), _size(0), _cap(0) {
+        reserve(max(vec.size(), 1));
+        for (int i = 0; i < vec.size(); ++i) {
+            re[i] = vec[i].getReal();
+            im[i] = vec[i].getImag();
+        }
+        _size = vec.size();
+        computeKeys();
+    }
+
+    ~ComplexVector() {
+        delete[] re;
+        delete[] im;
+        delete[] key;
+    }
+
+    ComplexVector(const ComplexVector&) = delete;
+    ComplexVector& operator=(const ComplexVector&) = delete;
+
+    int size() const { return _size; }
+    double realAt(int i) const { return re[i]; }
+    double imagAt(int i) const { return im[i]; }
+    double keyAt(int i) const { return key[i]; } // 模的平方
+    Complex operator[](int i) const { return Complex(re[i], im[i]); }
+
+    // 追加元素（键同时更新）
+    void push_back(const Complex& c) {
+        if (_size == _cap) reserve(_cap * 2);
+        re[_size] = c.getReal();
+        im[_size] = c.getImag();
+        key[_size] = c.squaredModulus();
+        _size++;
+    }
+
+    // 批量计算 key[i] = re[i]^2 + im[i]^2（AVX 每次 4 个，SSE2 每次 2 个）
+    void computeKeys() {
+        int i = 0;
+#if defined(__AVX__)
+        for (; i + 4 <= _size; i += 4) {
+            __m256d r = _mm256_loadu_pd(re + i);
+            __m256d m = _mm256_loadu_pd(im + i);
+            _mm256_storeu_pd(key + i, _mm256_add_pd(_mm256_mul_pd(r, r), _mm256_mul_pd(m, m)));
+        }
+#elif defined(__SSE2__)
+        for (; i + 2 <= _size; i += 2) {
+            __m128d r = _mm_loadu_pd(re + i);
+            __m128d m = _mm_loadu_pd(im + i);
+            _mm_storeu_pd(key + i, _mm_add_pd(_mm_mul_pd(r, r), _mm_mul_pd(m, m)));
+        }
+#endif
+        for (; i < _size; i++) key[i] = re[i] * re[i] + im[i] * im[i];
+    }
+
+    // 按模排序（模相同按实部，再相同保持原顺序，与 mergeSort 结果一致）：
+    // 非负 double 的位模式与数值同序，因此对键做 4 趟 16 位 LSD 基数排序，
+    // 再把键相同的区段按实部稳定排序。每趟只是顺序读、分散写三列，开销由内存带宽决定。
+    void sortByModulus() {
+        if (_size < 64) {
+            insertionSort(0, _size);
+            return;
+        }
+        const int RADIX = 1 << 16;
+        // 临时数组按容量分配：奇数趟后它们与原数组交换，交换后的数组仍需容纳 _cap 个元素
+        double* tre = new double[_cap];
+        double* tim = new double[_cap];
+        double* tkey = new double[_cap];
+        int* count = new int[RADIX];
+        for (int shift = 0; shift < 64; shift += 16) {
+            memset(count, 0, sizeof(int) * RADIX);
+            for (int i = 0; i < _size; i++) {
+                uint64_t bits;
+                memcpy(&bits, key + i, sizeof(bits));
+                count[(bits >> shift) & 0xFFFF]++;
+            }
+            // 所有元素这一位都相同（常见于高位），跳过本趟
+            bool trivial = false;
+            for (int d = 0; d < RADIX; d++) {
+                if (count[d] == _size) { trivial = true; break; }
+                if (count[d] != 0) break;
+            }
+            if (trivial) continue;
+            for (int d = 0, sum = 0; d < RADIX; d++) {
+                int c = count[d];
+                count[d] = sum;
+                sum += c;
+            }
+            for (int i = 0; i < _size; i++) {
+                uint64_t bits;
+                memcpy(&bits, key + i, sizeof(bits));
+                int dst = count[(bits >> shift) & 0xFFFF]++;
+                tkey[dst] = key[i];
+                tre[dst] = re[i];
+                tim[dst] = im[i];
+            }
+            swap(key, tkey);
+            swap(re, tre);
+            swap(im, tim);
+        }
+        delete[] tre;
+        delete[] tim;
+        delete[] tkey;
+        delete[] count;
+
+        // 键相同的区段按实部排序：短区段插入排序，长区段（如整数坐标时大量同模）稳定归并，O(k log k)
+        for (int lo = 0; lo < _size;) {
+            int hi = lo + 1;
+            while (hi < _size && key[hi] == key[lo]) hi++;
+            if (hi - lo > 32) sortRunByReal(lo, hi);
+            else if (hi - lo > 1) insertionSort(lo, hi);
+            lo = hi;
+        }
+    }
+
+    // 检查是否已按（模，实部）有序
+    bool isSorted() const {
+        for (int i = 1; i < _size; i++) {
+            if (lessAt(i, i - 1)) return false;
+        }
+        return true;
+    }
+
+    // 第一个模 >= m 的秩（要求已 sortByModulus，O(log n)）
+    int lowerBound(double m) const { return lowerBoundFrom(0, squaredThreshold(m)); }
+
+    // 第一个模 > m 的秩
+    int upperBound(double m) const { return lowerBound(nextafter(m, HUGE_VAL)); }
+
+    // 模介于 [m1, m2) 的秩区间
+    RankRange range(double m1, double m2) const {
+        int lo = lowerBound(m1);
+        return {lo, max(lo, lowerBound(m2))};
+    }
+
+    // 批量区间查询：第 i 个查询为 [m1[i], m2[i])，结果写入 out[i]。
+    // 先把 2q 个阈值排序，再用一个只前进的指针扫一遍键数组，每步用倍增 + 二分定位，
+    // 总代价 O(q log q + q log(n / q))，远小于 q 次独立扫描。
+    void batchRange(const double* m1, const double* m2, int q, RankRange* out) const {
+        struct Probe {
+            double t; // 平方阈值
+            int id;   // 2 * 查询号 + (0 下界 / 1 上界)
+        };
+        Probe* probes = new Probe[2 * q];
+        for (int i = 0; i < q; i++) {
+            probes[2 * i] = {squaredThreshold(m1[i]), 2 * i};
+            probes[2 * i + 1] = {squaredThreshold(m2[i]), 2 * i + 1};
+        }
+        sort(probes, probes + 2 * q, [](const Probe& a, const Probe& b) { return a.t < b.t; });
+        int pos = 0;
+        for (int k = 0; k < 2 * q; k++) {
+            pos = lowerBoundFrom(pos, probes[k].t);
+            int id = probes[k].id;
+            if (id & 1) out[id >> 1].hi = pos;
+            else out[id >> 1].lo = pos;
+        }
+        for (int i = 0; i < q; i++) out[i].hi = max(out[i].lo, out[i].hi);
+        delete[] probes;
+    }
+
+    // 从 from 开始找第一个 key >= t 的秩：先倍增跨步，再在最后一步内二分
+    int lowerBoundFrom(int from, double t) const {
+        if (from >= _size || key[from] >= t) return from;
+        int lo = from, step = 1; // 不变式：key[lo] < t
+        while (lo + step < _size && key[lo + step] < t) {
+            lo += step;
+            step <<= 1;
+        }
+        int hi = min(lo + step, _size); // key[hi] >= t 或 hi == _size
+        lo++;
+        while (lo < hi) {
+            int mid = lo + (hi - lo) / 2;
+            if (key[mid] < t) lo = mid + 1;
+            else hi = mid;
+        }
+        return lo;
+    }
+
+    // 转回 Vector<Complex>
+    Vector<Complex> toVector() const {
+        Vector<Complex> vec(max(_size, 1));
+        for (int i = 0; i < _size; i++) vec.push_back(Complex(re[i], im[i]));
+        return vec;
+    }
+};
+
 // 打印向量
 void printVector(const Vector<Complex>& vec, const string& msg = "") {
     if (!msg.empty()) {
@@ -159,3 +460,136 @@ void printVector(const Vector<Complex>& vec, const string& msg = "") {
 }
 
 
+
+// 整数坐标的随机复数（坐标在 [0, range) 内，同模元素很多，用来考察键相同时的实部排序）
+Vector<Complex> generateGridComplexVector(int size, int range, uint64_t seed = DEFAULT_SEED) {
+    Vector<Complex> vec(max(size, 1));
+    vec.resize(size);
+    parallelGenerate(vec.data(), size, seed, 0, [range](Xoshiro256& rng) {
+        return Complex((double)rng.nextBelow(range), (double)rng.nextBelow(range));
+    });
+    return vec;
+}
+
+// SoA 向量与 Vector<Complex> 的元素序列是否完全相同
+bool sameOrder(const ComplexVector& cv, const Vector<Complex>& vec) {
+    if (cv.size() != vec.size()) return false;
+    for (int i = 0; i < vec.size(); i++) {
+        if (!(cv[i] == vec[i])) return false;
+    }
+    return true;
+}
+
+// 随机数据（连续坐标 / 整数坐标）上对比 sortByModulus 与起泡排序、归并排序的结果顺序；
+// 另外检查排序后继续 push_back（排序会交换内部数组，容量必须保持不变）
+bool testSortByModulus(int rounds = 40) {
+    Xoshiro256 rng(DEFAULT_SEED);
+    for (int r = 0; r < rounds; r++) {
+        int n = (int)rng.nextInt(0, r % 4 == 0 ? 1500 : 100000);
+        Vector<Complex> vec = r % 2 ? generateGridComplexVector(n, (int)rng.nextInt(1, 20), DEFAULT_SEED + r)
+                                    : generateRandomComplexVector(n, -100, 100, DEFAULT_SEED + r);
+        ComplexVector cv(vec);
+        cv.sortByModulus();
+        if (!cv.isSorted()) return false;
+        if (r % 4 == 0) bubbleSort(vec);
+        else mergeSort(vec, 0, vec.size() - 1);
+        if (!sameOrder(cv, vec)) return false;
+    }
+
+    ComplexVector cv(1000);
+    for (int i = 0; i < 100; i++) cv.push_back(Complex(1 + ldexp((double)i, -36), 0));
+    cv.sortByModulus();
+    for (int i = 0; i < 200; i++) cv.push_back(Complex(i, -i));
+    cv.sortByModulus();
+    return cv.size() == 300 && cv.isSorted();
+}
+
+// 按模排序后的区间查询与暴力逐个比较 modulus() 对照：lowerBound / upperBound / range / batchRange
+// 以及 Vector 版的 modulusRange / rangeSearch。查询端点包括恰好等于某个元素的模、m1 == m2、
+// m1 > m2 和负数
+bool testRangeQueries(int rounds = 40) {
+    Xoshiro256 rng(DEFAULT_SEED);
+    for (int r = 0; r < rounds; r++) {
+        int n = (int)rng.nextInt(0, 3000);
+        Vector<Complex> vec = r % 2 ? generateGridComplexVector(n, 10, DEFAULT_SEED + r)
+                                    : generateRandomComplexVector(n, -50, 50, DEFAULT_SEED + r);
+        mergeSort(vec, 0, vec.size() - 1);
+        ComplexVector cv(vec);
+        cv.sortByModulus();
+        int q = (int)rng.nextInt(1, 500);
+        Vector<double> m1, m2;
+        m1.resize(q);
+        m2.resize(q);
+        auto pick = [&]() -> double {
+            switch (rng.nextBelow(4)) {
+            case 0: return n > 0 ? vec[(int)rng.nextBelow(n)].modulus() : 1.0; // 恰好是某个元素的模
+            case 1: return -rng.nextDouble() * 10;
+            default: return rng.nextDouble() * 80;
+            }
+        };
+        for (int i = 0; i < q; i++) {
+            m1[i] = pick();
+            m2[i] = rng.nextBelow(8) == 0 ? m1[i] : pick();
+        }
+        RankRange* batch = new RankRange[q];
+        cv.batchRange(m1.data(), m2.data(), q, batch);
+        bool ok = true;
+        for (int i = 0; i < q && ok; i++) {
+            int below1 = 0, atMost1 = 0, below2 = 0;
+            for (int k = 0; k < n; k++) {
+                double mod = vec[k].modulus();
+                below1 += mod < m1[i];
+                atMost1 += mod <= m1[i];
+                below2 += mod < m2[i];
+            }
+            RankRange expect = {below1, max(below1, below2)};
+            RankRange got = cv.range(m1[i], m2[i]);
+            RankRange vr = modulusRange(vec, m1[i], m2[i]);
+            Vector<Complex> found = rangeSearch(vec, m1[i], m2[i]);
+            ok = cv.lowerBound(m1[i]) == below1 && cv.upperBound(m1[i]) == atMost1 &&
+                 modulusLowerBound(vec, m1[i]) == below1 && modulusUpperBound(vec, m1[i]) == atMost1 &&
+                 got.lo == expect.lo && got.hi == expect.hi && batch[i].lo == expect.lo &&
+                 batch[i].hi == expect.hi && vr.lo == expect.lo && vr.hi == expect.hi &&
+                 found.size() == expect.size();
+            for (int k = 0; ok && k < found.size(); k++) {
+                double mod = found[k].modulus();
+                ok = mod >= m1[i] && mod < m2[i] && found[k] == vec[expect.lo + k];
+            }
+        }
+        delete[] batch;
+        if (!ok) return false;
+    }
+    return true;
+}
+
+// 按模排序的耗时：SoA 键（SIMD 求键 + 基数排序）对比原来逐次比较的归并排序
+void benchSortByModulus(const char* name, const Vector<Complex>& data) {
+    auto t0 = chrono::steady_clock::now();
+    ComplexVector cv(data);
+    cv.sortByModulus();
+    auto t1 = chrono::steady_clock::now();
+    Vector<Complex> vec = data;
+    mergeSort(vec, 0, vec.size() - 1);
+    auto t2 = chrono::steady_clock::now();
+    cout << name << "（" << data.size() << " 个）：SoA 基数排序 " << chrono::duration<double>(t1 - t0).count()
+         << " s，归并排序 " << chrono::duration<double>(t2 - t1).count() << " s，"
+         << (sameOrder(cv, vec) ? "结果一致" : "结果不一致！") << endl;
+}
+
+// 用法：1 [排序规模]（缺省 1000 万）
+int main(int argc, char* argv[]) {
+    int n = argc >= 2 ? atoi(argv[1]) : 10000000;
+    if (n < 1) n = 1;
+    cout << "===== 复数向量实验（exp1/1）=====" << endl;
+    Vector<Complex> demo = generateRandomComplexVector(8, -10, 10);
+    printVector(demo, "随机复数向量：");
+    ComplexVector sorted(demo);
+    sorted.sortByModulus();
+    printVector(sorted.toVector(), "按模排序：");
+
+    cout << "按模排序随机测试：" << (testSortByModulus() ? "与起泡 / 归并排序一致" : "结果不一致！") << endl;
+    cout << "模区间查询随机测试：" << (testRangeQueries() ? "与逐个比较一致" : "结果不一致！") << endl;
+    benchSortByModulus("均匀随机坐标", generateRandomComplexVector(n, -1000, 1000));
+    benchSortByModulus("整数坐标 0..19", generateGridComplexVector(n / 5, 20));
+    return 0;
+}
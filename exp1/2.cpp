@@ -2,7 +2,14 @@
 #include <string>
 #include <cctype>
 #include <unordered_map>
+#include <atomic>
+#include <chrono>
+#include <charconv>
+#include <cstdlib>
+#include "MySTL/Vector.h"
 #include "MySTL/Stack.h"
+#include "MySTL/Parallel.h"
+#include "MySTL/FileIO.h"
 
 using namespace std;
 
@@ -85,8 +92,216 @@ double calculate(const string& expr) {
     return calculatePostfix(postfix);
 }
 
+// 单趟表达式求值器：直接在字符区间上做调度场算法，不生成后缀串、不复制 std::string。
+// 两个栈都是连续数组，clear() 保留容量，一个线程持有一个求值器即可反复复用。
+class ExprEvaluator {
+private:
+    ArrayStack<double> numStk;
+    ArrayStack<char> opStk;
+
+    static int priority(char op) {
+        return (op == '*' || op == '/') ? 2 : (op == '+' || op == '-') ? 1 : 0;
+    }
+
+    // 弹出一个操作符和两个操作数，计算后压回
+    void applyTop() {
+        char op = opStk.pop();
+        if (numStk.size() < 2) throw runtime_error("Missing operand");
+        double b = numStk.pop();
+        double a = numStk.pop();
+        switch (op) {
+            case '+': numStk.push(a + b); break;
+            case '-': numStk.push(a - b); break;
+            case '*': numStk.push(a * b); break;
+            case '/':
+                if (b == 0) throw runtime_error("Division by zero");
+                numStk.push(a / b);
+                break;
+        }
+    }
+
+public:
+    // 计算 [p, end) 中的表达式，出错时抛出 runtime_error
+    double evaluate(const char* p, const char* end) {
+        numStk.clear();
+        opStk.clear();
+        bool expectOperand = true; // 当前位置应出现数字或左括号
+        while (p < end) {
+            char c = *p;
+            if (isspace((unsigned char)c)) {
+                p++;
+            } else if (isdigit((unsigned char)c) || c == '.') {
+                if (!expectOperand) throw runtime_error("Missing operator");
+                // 快速路径：不超过 15 位的纯整数直接累加（结果精确），其余交给 strtod
+                const char* q = p;
+                long long iv = 0;
+                while (q < end && q - p < 15 && isdigit((unsigned char)*q)) iv = iv * 10 + (*q++ - '0');
+                if (q > p && (q == end || (!isdigit((unsigned char)*q) && *q != '.'))) {
+                    numStk.push((double)iv);
+                    p = q;
+                    expectOperand = false;
+                    continue;
+                }
+                char buf[64];
+                int len = 0;
+                while (p < end && (isdigit((unsigned char)*p) || *p == '.')) {
+                    if (len == 63) throw runtime_error("Number too long");
+                    buf[len++] = *p++;
+                }
+                buf[len] = '\0';
+                char* stop;
+                double val = strtod(buf, &stop);
+                if (stop != buf + len) throw runtime_error("Invalid number");
+                numStk.push(val);
+                expectOperand = false;
+            } else if (c == '(') {
+                if (!expectOperand) throw runtime_error("Missing operator");
+                opStk.push(c);
+                p++;
+            } else if (c == ')') {
+                if (expectOperand) throw runtime_error("Missing operand");
+                while (!opStk.empty() && opStk.top() != '(') applyTop();
+                if (opStk.empty()) throw runtime_error("Mismatched parenthesis");
+                opStk.pop();
+                p++;
+            } else if (c == '+' || c == '-' || c == '*' || c == '/') {
+                if (expectOperand) throw runtime_error("Missing operand");
+                while (!opStk.empty() && opStk.top() != '(' && priority(opStk.top()) >= priority(c)) {
+                    applyTop();
+                }
+                opStk.push(c);
+                expectOperand = true;
+                p++;
+            } else {
+                throw runtime_error("Invalid character");
+            }
+        }
+        if (expectOperand) throw runtime_error("Missing operand");
+        while (!opStk.empty()) {
+            if (opStk.top() == '(') throw runtime_error("Mismatched parenthesis");
+            applyTop();
+        }
+        return numStk.pop();
+    }
+
+    double evaluate(const string& expr) {
+        return evaluate(expr.data(), expr.data() + expr.size());
+    }
+};
+
+// 批量求值统计
+struct BatchStats {
+    long long exprs;  // 表达式（非空行）个数
+    long long errors; // 出错行数
+    double seconds;   // 总耗时
+};
+
+// 求值 [p, end) 中的所有行，结果逐行追加到 out（空行输出空行，出错行输出 "error: 原因"）
+static void evaluateLines(ExprEvaluator& ev, const char* p, const char* end,
+                          string& out, long long& exprs, long long& errors) {
+    char num[32];
+    while (p < end) {
+        const char* eol = (const char*)memchr(p, '\n', end - p);
+        if (!eol) eol = end;
+        const char* lineEnd = eol;
+        if (lineEnd > p && lineEnd[-1] == '\r') lineEnd--;
+        const char* q = p;
+        while (q < lineEnd && isspace((unsigned char)*q)) q++;
+        if (q < lineEnd) {
+            exprs++;
+            try {
+                // to_chars 输出可精确回读的最短表示，比 printf 系列快得多
+                to_chars_result r = to_chars(num, num + sizeof(num), ev.evaluate(q, lineEnd));
+                out.append(num, r.ptr - num);
+            } catch (const exception& e) {
+                errors++;
+                out += "error: ";
+                out += e.what();
+            }
+        }
+        out += '\n';
+        p = eol + 1;
+    }
+}
+
+// 批量模式：内存映射输入文件，按行对齐切块后多线程求值，结果按输入顺序写入 outPath。
+// 为限制内存占用，按轮处理：每轮最多 2 * threads 块，每块约 chunkBytes 字节。
+BatchStats evaluateBatch(const char* inPath, const char* outPath, int threads = 0,
+                         size_t chunkBytes = 4 << 20) {
+    MappedFile in;
+    if (!in.open(inPath)) throw runtime_error(string("Cannot open input file: ") + inPath);
+    BufferedWriter writer;
+    if (!writer.open(outPath)) throw runtime_error(string("Cannot open output file: ") + outPath);
+
+    threads = resolveThreads(threads);
+    const int chunksPerRound = threads * 2;
+    Vector<const char*> bounds;        // 本轮各块的起点，最后一个元素为本轮终点
+    string* outs = new string[chunksPerRound];
+    ExprEvaluator* evals = new ExprEvaluator[threads];
+    BatchStats stats = {0, 0, 0};
+
+    auto t0 = chrono::steady_clock::now();
+    const char* p = in.data();
+    const char* end = p + in.size();
+    while (p < end) {
+        // 1. 切出本轮的块，块边界对齐到换行符之后
+        bounds.clear();
+        bounds.push_back(p);
+        while (p < end && bounds.size() <= chunksPerRound) {
+            const char* cut = p + min(chunkBytes, (size_t)(end - p));
+            if (cut < end) {
+                const char* nl = (const char*)memchr(cut, '\n', end - cut);
+                cut = nl ? nl + 1 : end;
+            }
+            p = cut;
+            bounds.push_back(p);
+        }
+        int nChunks = bounds.size() - 1;
+
+        // 2. 各线程从共享计数器领取块并求值
+        atomic<int> next(0);
+        atomic<long long> exprs(0), errors(0);
+        parallelRun(min(threads, nChunks), [&](int tid) {
+            long long myExprs = 0, myErrors = 0;
+            for (int c; (c = next.fetch_add(1)) < nChunks;) {
+                outs[c].clear();
+                evaluateLines(evals[tid], bounds[c], bounds[c + 1], outs[c], myExprs, myErrors);
+            }
+            exprs += myExprs;
+            errors += myErrors;
+        });
+        stats.exprs += exprs;
+        stats.errors += errors;
+
+        // 3. 按输入顺序写出
+        for (int c = 0; c < nChunks; c++) writer.write(outs[c].data(), outs[c].size());
+    }
+    bool written = writer.close();
+    stats.seconds = chrono::duration<double>(chrono::steady_clock::now() - t0).count();
+
+    delete[] outs;
+    delete[] evals;
+    if (!written) throw runtime_error(string("Write failed: ") + outPath);
+    return stats;
+}
+
 // 案例测试
-int main() {
+int main(int argc, char* argv[]) {
+    // 批量模式：2 --batch <输入文件> <输出文件|-> [线程数]
+    if (argc >= 4 && string(argv[1]) == "--batch") {
+        try {
+            int threads = argc >= 5 ? atoi(argv[4]) : 0;
+            BatchStats st = evaluateBatch(argv[2], argv[3], threads);
+            cerr << "表达式: " << st.exprs << "，出错: " << st.errors
+                 << "，耗时: " << st.seconds << " s，吞吐: "
+                 << (st.seconds > 0 ? st.exprs / st.seconds : 0) << " 表达式/秒" << endl;
+        } catch (const exception& e) {
+            cerr << "Error: " << e.what() << endl;
+            return 1;
+        }
+        return 0;
+    }
+
     try {
         string expr1 = "3+4*2";
         cout << expr1 << " = " << calculate(expr1) << endl;
@@ -2,26 +2,175 @@
 #include <random>
 #include "MySTL/Vector.h"
 #include "MySTL/Stack.h"
+#include "MySTL/Parallel.h"
 
 using namespace std;
 
-// 计算柱状图中最大矩形面积
-int largestRectangleArea(Vector<int>& heights) {
-    Stack<int> stk;
-    heights.push_back(0); // 哨兵，确保最后所有元素出栈
-    int maxArea = 0;
-    for (int i = 0; i < heights.size(); ++i) {
-        while (!stk.empty() && heights[stk.top()] > heights[i]) {
-            int h = heights[stk.pop()];
-            int w = stk.empty() ? i : i - stk.top() - 1;
-            maxArea = max(maxArea, h * w);
+// 流式柱状图最大矩形：高度可以分块逐段送入，只保留单调栈（O(栈深) 内存），面积用 64 位计算。
+// 栈中每根柱子记录它能向左延伸到的起点，因此不需要回看已经送入的高度。
+class HistogramScanner {
+private:
+    struct Bar {
+        long long start; // 该高度向左能延伸到的最远位置
+        int height;
+    };
+    ArrayStack<Bar> stk;
+    long long pos;  // 已送入的柱子个数
+    long long best; // 当前最大面积
+
+    // 以高度 h 出现在 pos 处：弹出所有不低于 h 的柱子并结算，返回 h 的起点
+    long long settle(int h) {
+        long long start = pos;
+        while (!stk.empty() && stk.peek(0).height >= h) {
+            Bar b = stk.pop();
+            best = max(best, (long long)b.height * (pos - b.start));
+            start = b.start;
         }
-        stk.push(i);
+        return start;
+    }
+
+public:
+    HistogramScanner() : pos(0), best(0) {}
+
+    void reset() {
+        stk.clear();
+        pos = 0;
+        best = 0;
+    }
+
+    // 送入一根柱子
+    void feed(int h) {
+        long long start = settle(h);
+        if (h > 0) stk.push({start, h});
+        pos++;
+    }
+
+    // 送入一段连续的柱子
+    void feed(const int* h, int n) {
+        for (int i = 0; i < n; i++) feed(h[i]);
+    }
+
+    // 结束当前柱状图（相当于在末尾放高度 0 的哨兵），返回最大面积并重置
+    long long finish() {
+        settle(0);
+        long long res = best;
+        reset();
+        return res;
     }
-    heights.pop_back(); // 还原原数组
-    return maxArea;
+};
+
+// 计算柱状图中最大矩形面积（不修改输入，面积用 64 位避免 h * w 溢出）
+long long largestRectangleArea(const Vector<int>& heights) {
+    HistogramScanner scanner;
+    for (int i = 0; i < heights.size(); ++i) {
+        scanner.feed(heights[i]);
+    }
+    return scanner.finish();
 }
 
+// 01 矩阵中全 1 的最大矩形：按行增量送入，每行更新列高后转化为柱状图问题。
+// 单线程时直接用 HistogramScanner；列数足够大时把列切成若干带并行处理：
+//   1. 各带并行更新列高，并用跳跃指针在带内求左右最近的更矮列 L/R；
+//   2. 对带内找不到的列（只可能是带内前缀/后缀最小值）顺序跨带补全；
+//   3. 各带并行求 h[j] * (R[j] - L[j] - 1) 的最大值。
+class MaximalRectangle {
+private:
+    int W;          // 列数
+    int bands;      // 列带个数
+    int* heights;   // 每列连续 1 的高度
+    int* L;         // 左侧最近的更矮列（-1 表示没有）
+    int* R;         // 右侧最近的更矮列（W 表示没有）
+    long long best;
+    HistogramScanner scanner;
+
+    int bandLo(int b) const { return (int)((long long)W * b / bands); }
+
+    void addRowSerial(const unsigned char* row) {
+        for (int j = 0; j < W; j++) heights[j] = row[j] ? heights[j] + 1 : 0;
+        scanner.feed(heights, W);
+        best = max(best, scanner.finish());
+    }
+
+    void addRowBanded(const unsigned char* row) {
+        int* h = heights;
+        // 1. 带内并行：更新列高，求带内的 L / R
+        parallelRun(bands, [&](int b) {
+            int lo = bandLo(b), hi = bandLo(b + 1);
+            for (int j = lo; j < hi; j++) h[j] = row[j] ? h[j] + 1 : 0;
+            for (int j = lo; j < hi; j++) {
+                int k = j - 1;
+                while (k >= lo && h[k] >= h[j]) k = L[k];
+                L[j] = k;
+            }
+            for (int j = hi - 1; j >= lo; j--) {
+                int k = j + 1;
+                while (k < hi && h[k] >= h[j]) k = R[k];
+                R[j] = k;
+            }
+        });
+        // 2. 顺序跨带补全：悬空的列按顺序高度单调，下一列可从上一列的结果继续跳
+        for (int b = 1; b < bands; b++) {
+            int lo = bandLo(b), hi = bandLo(b + 1);
+            int k = lo - 1;
+            for (int j = lo; j < hi; j++) {
+                if (L[j] != lo - 1) continue;
+                while (k >= 0 && h[k] >= h[j]) k = L[k];
+                L[j] = k;
+            }
+        }
+        for (int b = bands - 2; b >= 0; b--) {
+            int lo = bandLo(b), hi = bandLo(b + 1);
+            int k = hi;
+            for (int j = hi - 1; j >= lo; j--) {
+                if (R[j] != hi) continue;
+                while (k < W && h[k] >= h[j]) k = R[k];
+                R[j] = k;
+            }
+        }
+        // 3. 各带并行求最大面积
+        long long* bandBest = new long long[bands];
+        parallelRun(bands, [&](int b) {
+            long long m = 0;
+            for (int j = bandLo(b), hi = bandLo(b + 1); j < hi; j++) {
+                m = max(m, (long long)h[j] * (R[j] - L[j] - 1));
+            }
+            bandBest[b] = m;
+        });
+        for (int b = 0; b < bands; b++) best = max(best, bandBest[b]);
+        delete[] bandBest;
+    }
+
+public:
+    // width：列数；threads：线程数（<= 0 为全部硬件线程）；每带至少 minBand 列才值得并行
+    MaximalRectangle(int width, int threads = 1, int minBand = 1 << 16)
+        : W(width), L(nullptr), R(nullptr), best(0) {
+        bands = max(1, min(resolveThreads(threads), W / max(1, minBand)));
+        heights = new int[W]();
+        if (bands > 1) {
+            L = new int[W];
+            R = new int[W];
+        }
+    }
+
+    ~MaximalRectangle() {
+        delete[] heights;
+        delete[] L;
+        delete[] R;
+    }
+
+    MaximalRectangle(const MaximalRectangle&) = delete;
+    MaximalRectangle& operator=(const MaximalRectangle&) = delete;
+
+    // 送入下一行（长度为 W，非 0 视为 1）
+    void addRow(const unsigned char* row) {
+        if (bands > 1) addRowBanded(row);
+        else addRowSerial(row);
+    }
+
+    // 到目前为止出现过的最大全 1 矩形面积
+    long long area() const { return best; }
+};
+
 // 随机生成测试数据并测试
 void testRandomCases() {
     default_random_engine e;
@@ -42,11 +191,72 @@ void testRandomCases() {
         if (n > 10) cout << "...";
         cout << endl;
         
-        int area = largestRectangleArea(heights);
+        long long area = largestRectangleArea(heights);
         cout << "最大矩形面积: " << area << endl << endl;
     }
 }
 
+// 暴力求柱状图最大矩形（O(n^2)），用于校验
+long long bruteHistogram(const int* h, int n) {
+    long long best = 0;
+    for (int i = 0; i < n; i++) {
+        int low = h[i];
+        for (int j = i; j < n; j++) {
+            low = min(low, h[j]);
+            best = max(best, (long long)low * (j - i + 1));
+        }
+    }
+    return best;
+}
+
+// 校验流式版本（随机分块送入）与 01 矩阵版本（单线程 / 多列带）
+void testStreamingAndMatrix() {
+    default_random_engine e(2025);
+    uniform_int_distribution<int> valDist(0, 20);
+    bool ok = true;
+
+    for (int t = 0; t < 200 && ok; ++t) {
+        int n = 1 + e() % 300;
+        int* h = new int[n];
+        for (int i = 0; i < n; i++) h[i] = valDist(e);
+        HistogramScanner scanner;
+        for (int i = 0; i < n;) { // 随机长度分块送入
+            int len = min(n - i, 1 + (int)(e() % 17));
+            scanner.feed(h + i, len);
+            i += len;
+        }
+        if (scanner.finish() != bruteHistogram(h, n)) ok = false;
+        delete[] h;
+    }
+    cout << "流式版本随机校验: " << (ok ? "通过" : "失败") << endl;
+
+    // 64 位面积：20 万根高 10 万的柱子，面积 2e10 超出 int
+    HistogramScanner big;
+    for (int i = 0; i < 200000; i++) big.feed(100000);
+    cout << "大面积测试 (200000 x 100000): " << big.finish() << endl;
+
+    ok = true;
+    for (int t = 0; t < 50 && ok; ++t) {
+        int rows = 1 + e() % 20, cols = 1 + e() % 200;
+        unsigned char* m = new unsigned char[rows * cols];
+        for (int i = 0; i < rows * cols; i++) m[i] = (e() % 4) != 0;
+        MaximalRectangle serial(cols, 1);
+        MaximalRectangle banded(cols, 4, 8); // 每带至少 8 列，强制走多列带路径
+        int* colH = new int[cols]();
+        long long expect = 0;
+        for (int r = 0; r < rows; r++) {
+            serial.addRow(m + r * cols);
+            banded.addRow(m + r * cols);
+            for (int j = 0; j < cols; j++) colH[j] = m[r * cols + j] ? colH[j] + 1 : 0;
+            expect = max(expect, bruteHistogram(colH, cols));
+        }
+        if (serial.area() != expect || banded.area() != expect) ok = false;
+        delete[] colH;
+        delete[] m;
+    }
+    cout << "01 矩阵最大矩形随机校验: " << (ok ? "通过" : "失败") << endl << endl;
+}
+
 int main() {
     // 示例1测试
     Vector<int> heights1 = {2, 1, 5, 6, 2, 3};
@@ -66,6 +276,7 @@ int main() {
     
     // 随机测试
     testRandomCases();
+    testStreamingAndMatrix();
     
     return 0;
 }
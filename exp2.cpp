@@ -1,92 +1,195 @@
 #include "MySTL/Vector.h"
 #include "MySTL/list.h"
 #include "MySTL/Stack.h"
+#include "MySTL/BitStream.h"
+#include "MySTL/Random.h"
+#include "MySTL/FileIO.h"
+#include "MySTL/CRC32.h"
+#include "MySTL/Parallel.h"
+#include "MySTL/Histogram.h"
 #include <iostream>
-#include <fstream>
 #include <cstring>
 #include <queue>
+#include <vector>
+#include <algorithm>
 #include <map>
-#include <cctype>
+#include <cmath>
+#include <cstdint>
+#include <chrono>
+#include <stdexcept>
+#include <cstdlib>
+#include <string_view>
+#ifndef _WIN32
+#include <sys/resource.h>
+#include <sys/stat.h>
+#endif
 using namespace std;
 
-// 位图类（修复 const 限定符冲突，移除重复定义依赖）
-class Bitmap {
-private:
-    unsigned char* M;  // 存储位图的字节数组
-    Rank N;            // 字节数组长度（总比特数 = N * 8）
-    Rank _sz;          // 已使用的比特数
-
-    // 扩容：仅在非 const 操作中调用（避免 const 函数冲突）
-    void expand(Rank k) {
-        if (k < 8 * N) return;
-        Rank oldN = N;
-        unsigned char* oldM = M;
-        N = max(N * 2, (k + 7) / 8);
-        M = new unsigned char[N];
-        memset(M, 0, N);
-        memcpy(M, oldM, oldN);
-        delete[] oldM;
-    }
-
-    // 初始化：指定初始比特数（默认 8 位）
-    void init(Rank n = 8) {
-        N = (n + 7) / 8;
-        M = new unsigned char[N];
-        memset(M, 0, N);
-        _sz = 0;
-    }
+// 定长表示的码字：低 len 位为编码，先写高位
+struct HuffCodeWord {
+    uint64_t bits;
+    int len;
+};
 
-public:
-    // 构造函数
-    Bitmap(Rank n = 8) { init(n); }
+// 把 "0101" 形式的编码串转换为码字
+inline HuffCodeWord toCodeWord(const string& code) {
+    HuffCodeWord w = {0, (int)code.size()};
+    for (char c : code) w.bits = (w.bits << 1) | (c == '1');
+    return w;
+}
 
-    // 析构函数
-    ~Bitmap() {
-        delete[] M;
-        M = nullptr;
-        N = 0;
-        _sz = 0;
-    }
+// 码字转回 "0101" 形式的编码串（仅用于显示）
+inline string codeWordToString(const HuffCodeWord& w) {
+    string s;
+    for (int i = w.len - 1; i >= 0; i--) s += ((w.bits >> i) & 1) ? '1' : '0';
+    return s;
+}
+
+// 用 256 项码字表把 n 个字节编码进 out：每个字节一次查表 + 一次写入累加器。
+// 码长为 0 的符号不输出任何位
+inline void encodeBytes(const unsigned char* p, size_t n, const HuffCodeWord codes[256], BitWriter& out) {
+    for (size_t i = 0; i < n; i++) out.write(codes[p[i]].bits, codes[p[i]].len);
+}
 
-    // 返回已使用的比特数
-    Rank size() const { return _sz; }
+// 范式哈夫曼编码：只由各符号的码长决定码字。
+// 码长相同的符号按符号值递增依次取连续码字，较长码字接在较短码字之后，
+// 因此解码端只需知道码长表就能重建完全相同的编码。
+void assignCanonicalCodes(const unsigned char lens[256], HuffCodeWord codes[256]) {
+    int maxLen = 0;
+    int count[64] = {};
+    for (int s = 0; s < 256; s++) {
+        if (lens[s]) count[lens[s]]++;
+        maxLen = max(maxLen, (int)lens[s]);
+    }
+    uint64_t nextCode[64] = {};
+    uint64_t code = 0;
+    for (int len = 1; len <= maxLen; len++) {
+        code = (code + count[len - 1]) << 1;
+        nextCode[len] = code;
+    }
+    for (int s = 0; s < 256; s++) {
+        codes[s].len = lens[s];
+        codes[s].bits = lens[s] ? nextCode[lens[s]]++ : 0;
+    }
+}
 
-    // 设置第 k 位为 1（非 const 操作，可扩容）
-    void set(Rank k) {
-        expand(k);
-        M[k >> 3] |= (0x80 >> (k & 0x07));
-        _sz = max(_sz, k + 1);
+// 码长表头：3 位给出每个码长字段的位数 w，之后按符号 0..255 依次写码长（w 位）；
+// 码长为 0 时紧跟 8 位，表示其后还有多少个连续的 0 码长符号。
+// 26 个小写字母约 17 字节，满 256 个符号约 128 字节
+void writeCodeLengths(const unsigned char lens[256], BitWriter& out) {
+    int maxLen = 0;
+    for (int s = 0; s < 256; s++) maxLen = max(maxLen, (int)lens[s]);
+    int w = 1;
+    while ((1 << w) <= maxLen) w++;
+    out.write(w, 3);
+    for (int s = 0; s < 256;) {
+        out.write(lens[s], w);
+        if (lens[s] == 0) {
+            int run = 0;
+            while (s + 1 + run < 256 && run < 255 && lens[s + 1 + run] == 0) run++;
+            out.write(run, 8);
+            s += run + 1;
+        } else {
+            s++;
+        }
     }
+}
 
-    // 清空第 k 位为 0（非 const 操作，可扩容）
-    void clear(Rank k) {
-        expand(k);
-        M[k >> 3] &= ~(0x80 >> (k & 0x07));
-        if (k == _sz - 1) {
-            while (_sz > 0 && !test(_sz - 1)) _sz--;
+// 读取码长表头并校验（码长不超过 maxLen，满足 Kraft 不等式），非法时返回 false。
+// maxLen 缺省为解码器支持的上限 56，仅供内存中的演示使用；解码文件时应传入压缩端的上限，
+// 否则伪造的表头（如码长 1..39）会让解码器建出上 GB 的二级表
+bool readCodeLengths(BitReader& in, unsigned char lens[256], int maxLen = 56) {
+    int w = (int)in.read(3);
+    if (w == 0) return false;
+    for (int s = 0; s < 256;) {
+        int len = (int)in.read(w);
+        if (len > maxLen) return false;
+        lens[s++] = (unsigned char)len;
+        if (len == 0) {
+            int run = (int)in.read(8);
+            if (s + run > 256) return false;
+            for (int i = 0; i < run; i++) lens[s++] = 0;
         }
     }
+    // Kraft 和：sum 2^(56 - len) 不能超过 2^56
+    uint64_t kraft = 0;
+    for (int s = 0; s < 256; s++) {
+        if (lens[s]) kraft += 1ULL << (56 - lens[s]);
+        if (kraft > (1ULL << 56)) return false;
+    }
+    return true;
+}
 
-    // 测试第 k 位是否为 1（const 函数，不扩容，超出范围返回 false）
-    bool test(Rank k) const {
-        if (k >= 8 * N) return false;
-        return (M[k >> 3] & (0x80 >> (k & 0x07))) != 0;
+// 限长哈夫曼编码（package-merge）：在所有码长都不超过 maxLen 的前缀码中求加权码长最小者。
+// 把每个符号看作 maxLen 层中各一枚“硬币”（面值 2^-层号，权重为频率）：
+// 自最深层起，每层把上一层的有序列表两两打包，再与本层的叶子归并；
+// 最后在顶层取权重最小的 2n - 2 项，一个符号被选中（含打包在内）的次数就是它的码长。
+// 由于包总是由上一层列表中相邻的两项按序组成，选中前 k 项中的 p 个包恰好等于
+// 选中上一层的前 2p 项，因此只需记录每层每项是叶子还是包，自顶向下逐层计数即可。
+// 出现的符号超过 2^maxLen 个时无解，返回 false
+bool packageMergeLengths(const uint64_t freq[256], int maxLen, unsigned char lens[256]) {
+    memset(lens, 0, 256);
+    int sym[256], n = 0;
+    for (int s = 0; s < 256; s++) {
+        if (freq[s]) sym[n++] = s;
+    }
+    if (n == 0) return true;
+    if (n == 1) {
+        lens[sym[0]] = 1;
+        return true;
     }
+    if (maxLen < 1 || maxLen > 56 || (maxLen < 9 && (1 << maxLen) < n)) return false;
+    sort(sym, sym + n, [&](int a, int b) { return freq[a] != freq[b] ? freq[a] < freq[b] : a < b; });
 
-    // 将前 n 位转换为字符串（非 const 操作，确保容量）
-    char* bits2string(Rank n) {
-        if (n > 8 * N) expand(n - 1); // 提前扩容
-        char* s = new char[n + 1];
-        s[n] = '\0';
-        for (Rank i = 0; i < n; i++) {
-            s[i] = test(i) ? '1' : '0';
+    // item[l][i]：第 l 层归并后有序列表中的第 i 项，sym < 0 表示由上一层两项打包而成
+    struct Item {
+        uint64_t weight;
+        int sym;
+    };
+    const int width = 2 * n;
+    vector<Item> item((size_t)maxLen * width);
+    vector<int> size(maxLen);
+    for (int i = 0; i < n; i++) item[i] = {freq[sym[i]], sym[i]};
+    size[0] = n;
+    for (int l = 1; l < maxLen; l++) {
+        const Item* prev = &item[(size_t)(l - 1) * width];
+        Item* cur = &item[(size_t)l * width];
+        int packs = size[l - 1] / 2, i = 0, j = 0, k = 0;
+        while (i < n || j < packs) { // 叶子与包按权重归并，权重相同时叶子在前
+            uint64_t pw = j < packs ? prev[2 * j].weight + prev[2 * j + 1].weight : 0;
+            if (j >= packs || (i < n && freq[sym[i]] <= pw)) {
+                cur[k++] = {freq[sym[i]], sym[i]};
+                i++;
+            } else {
+                cur[k++] = {pw, -1};
+                j++;
+            }
         }
-        return s;
+        size[l] = k;
     }
-};
 
-// 哈夫曼编码类型（基于位图）
-typedef Bitmap HuffCode;
+    int take = 2 * n - 2;
+    for (int l = maxLen - 1; l >= 0 && take > 0; l--) {
+        const Item* cur = &item[(size_t)l * width];
+        int packs = 0;
+        for (int i = 0; i < take; i++) {
+            if (cur[i].sym >= 0) lens[cur[i].sym]++;
+            else packs++;
+        }
+        take = 2 * packs;
+    }
+    return true;
+}
+
+// 加权平均码长（位/符号）
+double averageCodeLength(const uint64_t freq[256], const unsigned char lens[256]) {
+    double total = 0, bits = 0;
+    for (int s = 0; s < 256; s++) {
+        total += (double)freq[s];
+        bits += (double)freq[s] * lens[s];
+    }
+    return total > 0 ? bits / total : 0;
+}
 
 // 哈夫曼树节点结构体
 template <typename T>
@@ -115,27 +218,15 @@ private:
         delete node;
     }
 
-    // 递归生成哈夫曼编码表（深度优先遍历）
-    void generateCode(HuffNode<T>* node, HuffCode& code, map<T, string>& codeMap) {
+    // 递归收集叶子深度作为码长
+    void collectLengths(HuffNode<T>* node, int depth, unsigned char lens[256]) {
         if (!node) return;
-
-        // 叶子节点：记录当前字符的编码
         if (!node->left && !node->right) {
-            char* bitStr = code.bits2string(code.size());
-            codeMap[node->data] = string(bitStr);
-            delete[] bitStr;
+            lens[(unsigned char)node->data] = (unsigned char)max(depth, 1);
             return;
         }
-
-        // 左子树：编码加 '0'
-        code.set(code.size());
-        generateCode(node->left, code, codeMap);
-        code.clear(code.size() - 1);
-
-        // 右子树：编码加 '1'
-        code.set(code.size());
-        generateCode(node->right, code, codeMap);
-        code.clear(code.size() - 1);
+        collectLengths(node->left, depth + 1, lens);
+        collectLengths(node->right, depth + 1, lens);
     }
 
 public:
@@ -176,40 +267,309 @@ public:
         }
     }
 
-    // 生成哈夫曼编码表
+    // 生成扁平码字表：用显式栈深度优先遍历，码字随路径直接移位累积（左 0 右 1），
+    // 未出现的符号码长为 0；只有一个字符时树根即叶子，约定编码为 "0"
+    void getCodeTable(HuffCodeWord table[256]) {
+        memset(table, 0, sizeof(HuffCodeWord) * 256);
+        if (!root) return;
+        struct Frame {
+            HuffNode<T>* node;
+            uint64_t bits;
+            int depth;
+        };
+        ArrayStack<Frame> stack;
+        stack.push({root, 0, 0});
+        while (!stack.empty()) {
+            Frame f = stack.pop();
+            if (!f.node->left && !f.node->right) {
+                HuffCodeWord& w = table[(unsigned char)f.node->data];
+                w.bits = f.bits;
+                w.len = max(f.depth, 1);
+                continue;
+            }
+            if (f.node->right) stack.push({f.node->right, (f.bits << 1) | 1, f.depth + 1});
+            if (f.node->left) stack.push({f.node->left, f.bits << 1, f.depth + 1});
+        }
+    }
+
+    // 生成哈夫曼编码表（"0101" 形式，仅用于显示）
     map<T, string> getCodeMap() {
         map<T, string> codeMap;
-        if (!root) return codeMap;
+        HuffCodeWord table[256];
+        getCodeTable(table);
+        for (int s = 0; s < 256; s++) {
+            if (table[s].len) codeMap[(T)s] = codeWordToString(table[s]);
+        }
+        return codeMap;
+    }
+
+    // 各字节符号的码长（未出现的符号为 0），只有一个符号时码长记为 1
+    void getCodeLengths(unsigned char lens[256]) {
+        memset(lens, 0, 256);
+        collectLengths(root, 0, lens);
+    }
 
-        HuffCode code;
-        generateCode(root, code, codeMap);
+    // 范式编码表：码长与 getCodeMap 相同，码字由 assignCanonicalCodes 重新分配
+    map<T, string> getCanonicalCodeMap() {
+        unsigned char lens[256];
+        HuffCodeWord codes[256];
+        getCodeLengths(lens);
+        assignCanonicalCodes(lens, codes);
+        map<T, string> codeMap;
+        for (int s = 0; s < 256; s++) {
+            if (lens[s]) codeMap[(T)s] = codeWordToString(codes[s]);
+        }
         return codeMap;
     }
 
-    // 对字符串进行编码
-    string encode(string str, map<T, string>& codeMap) {
-        string res;
-        for (char c : str) {
-            if (isalpha(c)) {
-                c = tolower(c);
-                auto it = codeMap.find(c);
-                if (it != codeMap.end()) {
-                    res += it->second;
-                }
+    // 零拷贝编码：直接读取 text 的字节，按码字表写入 out，返回写入的比特数
+    uint64_t encode(string_view text, const HuffCodeWord table[256], BitWriter& out) {
+        uint64_t before = out.bitCount();
+        encodeBytes((const unsigned char*)text.data(), text.size(), table, out);
+        return out.bitCount() - before;
+    }
+
+    // 按 "0101" 形式的码表编码字母文本：大写字母在表中指向对应小写字母的码字，
+    // 非字母的码长为 0，因此热循环里不再需要 isalpha / tolower
+    uint64_t encode(string_view text, const map<T, string>& codeMap, BitWriter& out) {
+        HuffCodeWord table[256] = {};
+        for (auto& pair : codeMap) {
+            table[(unsigned char)pair.first] = toCodeWord(pair.second);
+        }
+        for (int c = 'A'; c <= 'Z'; c++) {
+            if (table[c].len == 0) table[c] = table[c - 'A' + 'a'];
+        }
+        return encode(text, table, out);
+    }
+
+    // 加权码长总和：等于所有内部节点权重之和
+    uint64_t totalBits() {
+        uint64_t bits = 0;
+        if (!root) return 0;
+        ArrayStack<HuffNode<T>*> stack;
+        stack.push(root);
+        while (!stack.empty()) {
+            HuffNode<T>* node = stack.pop();
+            if (node->left) stack.push(node->left);
+            if (node->right) stack.push(node->right);
+            if (node->left || node->right) bits += (uint64_t)node->weight;
+        }
+        return bits;
+    }
+
+    // 计算压缩率：按实际输出的字节数（含末尾补齐）与原始字节数比较
+    double calculateCompressionRate(size_t originalBytes, size_t compressedBytes) {
+        if (originalBytes == 0) return 0.0;
+        return (1.0 - (double)compressedBytes / originalBytes) * 100;
+    }
+};
+
+// 数组版哈夫曼树：叶子按权重排序一次后用“双队列”合并，O(n) 建树（不计排序）。
+// 叶子按权重递增依次放在 [0, n)，新建的内部节点按创建顺序放在 [n, 2n - 1)；
+// 内部节点的权重随创建顺序单调不减，所以它们本身就构成第二个有序队列，
+// 每次只需比较两个队首就能取出最小的两个节点，不再需要优先队列和逐个 new。
+// 父节点的下标总大于子节点，从根（最后一个节点）倒序扫一遍即可求出全部深度，没有递归
+template <typename T>
+class HuffArrayTree {
+private:
+    Vector<T> _sym;           // _sym[i]：第 i 个叶子的符号
+    Vector<uint64_t> _weight; // 节点权重
+    Vector<int> _left;        // 内部节点 k 的子节点：_left[k - n] / _right[k - n]
+    Vector<int> _right;
+    Vector<int> _depth;       // 节点深度（叶子深度即码长）
+    int _n;                   // 叶子数
+
+public:
+    HuffArrayTree() : _n(0) {}
+
+    // 由 n 个（符号，权重）建树，权重为 0 的符号不参与
+    void build(const T* symbols, const uint64_t* weights, int n) {
+        Vector<int> order;
+        order.resize(n);
+        int* ord = order.data();
+        int m = 0;
+        for (int i = 0; i < n; i++) {
+            if (weights[i] > 0) ord[m++] = i;
+        }
+        sort(ord, ord + m, [&](int a, int b) { return weights[a] < weights[b]; });
+
+        _n = m;
+        int total = m > 0 ? 2 * m - 1 : 0;
+        _sym.resize(m);
+        _weight.resize(total);
+        _left.resize(m > 1 ? m - 1 : 0);
+        _right.resize(m > 1 ? m - 1 : 0);
+        _depth.resize(total);
+        T* sym = _sym.data();
+        uint64_t* w = _weight.data();
+        int *left = _left.data(), *right = _right.data(), *depth = _depth.data();
+        for (int i = 0; i < m; i++) {
+            sym[i] = symbols[ord[i]];
+            w[i] = weights[ord[i]];
+        }
+
+        // 双队列合并：leaf 指向下一个未用的叶子，node 指向下一个未用的内部节点
+        int leaf = 0, node = m;
+        for (int k = m; k < total; k++) {
+            int pick[2];
+            for (int t = 0; t < 2; t++) {
+                if (node < k && (leaf >= m || w[node] < w[leaf])) pick[t] = node++;
+                else pick[t] = leaf++;
             }
+            left[k - m] = pick[0];
+            right[k - m] = pick[1];
+            w[k] = w[pick[0]] + w[pick[1]];
+        }
+
+        // 自根向下求深度：父节点下标大于子节点，倒序扫描时父节点深度已经确定
+        if (total > 0) depth[total - 1] = 0;
+        for (int k = total - 1; k >= m; k--) {
+            depth[left[k - m]] = depth[k] + 1;
+            depth[right[k - m]] = depth[k] + 1;
         }
-        return res;
     }
 
-    // 计算压缩率
-    double calculateCompressionRate(string originalStr, string encodedStr) {
-        int originalBits = 0;
-        for (char c : originalStr) {
-            if (isalpha(c)) originalBits += 8;
+    // 由频率映射建树
+    void build(const map<T, int>& freqMap) {
+        Vector<T> symbols;
+        Vector<uint64_t> weights;
+        for (auto& pair : freqMap) {
+            symbols.push_back(pair.first);
+            weights.push_back((uint64_t)max(pair.second, 0));
+        }
+        build(symbols.data(), weights.data(), symbols.size());
+    }
+
+    // 叶子数
+    int leafCount() const { return _n; }
+
+    // 第 i 个叶子（按权重递增）的符号与码长；只有一个符号时码长记为 1
+    const T& symbolAt(int i) const { return _sym.data()[i]; }
+    int codeLengthAt(int i) const { return _n == 1 ? 1 : _depth.data()[i]; }
+
+    // 加权码长总和（编码后的总比特数）
+    uint64_t totalBits() const {
+        uint64_t bits = 0;
+        for (int i = 0; i < _n; i++) bits += _weight.data()[i] * codeLengthAt(i);
+        return bits;
+    }
+
+    // 各字节符号的码长（未出现的符号为 0），与 HuffTree::getCodeLengths 对应
+    void getCodeLengths(unsigned char lens[256]) const {
+        memset(lens, 0, 256);
+        for (int i = 0; i < _n; i++) lens[(unsigned char)symbolAt(i)] = (unsigned char)codeLengthAt(i);
+    }
+};
+
+// 频率表的香农熵（每个符号的平均比特数），是任何前缀码平均码长的下界
+double entropyBitsPerSymbol(const map<char, int>& freqMap) {
+    double total = 0, h = 0;
+    for (auto& pair : freqMap) total += pair.second;
+    for (auto& pair : freqMap) {
+        if (pair.second > 0) {
+            double p = pair.second / total;
+            h -= p * log2(p);
+        }
+    }
+    return h;
+}
+
+// 把位流前 nbits 位显示成 0/1 串（仅用于打印短编码）
+string bitsToString(const unsigned char* data, uint64_t nbits) {
+    string s;
+    BitReader reader(data, (size_t)((nbits + 7) / 8));
+    for (uint64_t i = 0; i < nbits; i++) s += reader.read(1) ? '1' : '0';
+    return s;
+}
+
+// 查表解码器：一级表以接下来的 PRIMARY_BITS 位为下标，绝大多数符号一次查表即可解出；
+// 更长的码字在一级表中指向二级表，二级表以剩余的位为下标。
+// 表项：叶子 = (码长 << 16) | 符号；链接 = LINK | (二级表位数 << 24) | 二级表起点
+class HuffDecoder {
+private:
+    static const int PRIMARY_BITS = 11;
+    static const uint32_t LINK = 0x80000000u;
+    uint32_t* table; // 一级表后面紧跟所有二级表
+    int maxLen;
+
+    static uint32_t leaf(int len, int sym) { return ((uint32_t)len << 16) | (uint32_t)sym; }
+
+public:
+    HuffDecoder() : table(nullptr), maxLen(0) {}
+    ~HuffDecoder() { delete[] table; }
+
+    HuffDecoder(const HuffDecoder&) = delete;
+    HuffDecoder& operator=(const HuffDecoder&) = delete;
+
+    // 由每个字节符号的码字建表（len == 0 表示该符号不出现），码表必须是前缀码
+    void build(const HuffCodeWord codes[256]) {
+        const int K = PRIMARY_BITS;
+        maxLen = 0;
+        for (int s = 0; s < 256; s++) maxLen = max(maxLen, codes[s].len);
+        if (maxLen > 56) throw runtime_error("Huffman code too long for table decoder");
+
+        // 统计每个一级前缀下二级表需要的位数
+        int subBits[1 << K] = {};
+        for (int s = 0; s < 256; s++) {
+            int len = codes[s].len;
+            if (len > K) {
+                uint64_t prefix = codes[s].bits >> (len - K);
+                subBits[prefix] = max(subBits[prefix], len - K);
+            }
+        }
+        size_t total = (size_t)1 << K;
+        for (int p = 0; p < (1 << K); p++) {
+            if (subBits[p]) total += (size_t)1 << subBits[p];
+        }
+        delete[] table;
+        table = new uint32_t[total](); // 0 表示非法前缀
+
+        size_t next = (size_t)1 << K;
+        for (int p = 0; p < (1 << K); p++) {
+            if (subBits[p]) {
+                table[p] = LINK | ((uint32_t)subBits[p] << 24) | (uint32_t)next;
+                next += (size_t)1 << subBits[p];
+            }
+        }
+        for (int s = 0; s < 256; s++) {
+            int len = codes[s].len;
+            if (len == 0) continue;
+            uint64_t code = codes[s].bits;
+            if (len <= K) {
+                size_t lo = (size_t)code << (K - len), cnt = (size_t)1 << (K - len);
+                for (size_t i = 0; i < cnt; i++) table[lo + i] = leaf(len, s);
+            } else {
+                uint32_t link = table[code >> (len - K)];
+                int sb = (link >> 24) & 0x7F;
+                size_t base = link & 0xFFFFFF;
+                size_t lo = (size_t)(code & ((1ULL << (len - K)) - 1)) << (sb - (len - K));
+                size_t cnt = (size_t)1 << (sb - (len - K));
+                for (size_t i = 0; i < cnt; i++) table[base + lo + i] = leaf(len, s);
+            }
+        }
+    }
+
+    // 由码长表按范式编码建表
+    void buildFromLengths(const unsigned char lens[256]) {
+        HuffCodeWord codes[256];
+        assignCanonicalCodes(lens, codes);
+        build(codes);
+    }
+
+    // 从 in 中解出 n 个符号写入 out
+    void decode(BitReader& in, unsigned char* out, size_t n) const {
+        const int K = PRIMARY_BITS;
+        for (size_t i = 0; i < n; i++) {
+            if (in.available() < maxLen) in.refill();
+            uint32_t e = table[in.peek(K)];
+            if (e & LINK) {
+                int sb = (e >> 24) & 0x7F;
+                e = table[(e & 0xFFFFFF) + (in.peek(K + sb) & ((1ULL << sb) - 1))];
+            }
+            if (e == 0) throw runtime_error("Invalid Huffman code in stream");
+            in.consume(e >> 16);
+            out[i] = (unsigned char)e;
         }
-        int encodedBits = encodedStr.size();
-        if (originalBits == 0) return 0.0;
-        return (1.0 - (double)encodedBits / originalBits) * 100;
     }
 };
 
@@ -220,8 +580,8 @@ map<char, int> countCharFrequency(const char* filename) {
         freqMap[c] = 0;
     }
 
-    ifstream file(filename);
-    if (!file.is_open()) {
+    MappedFile file;
+    if (!file.open(filename)) {
         cerr << "\n警告：未找到文本文件 \"" << filename << "\"，使用默认频率表！" << endl;
         freqMap = {
             {'a', 120}, {'b', 22}, {'c', 32}, {'d', 42}, {'e', 128},
@@ -233,13 +593,12 @@ map<char, int> countCharFrequency(const char* filename) {
         return freqMap;
     }
 
-    char c;
-    while (file.get(c)) {
-        if (isalpha(c)) {
-            freqMap[tolower(c)]++;
-        }
+    // 整个文件走一遍扁平直方图（多线程），再把大小写字母合并到 map 中
+    uint64_t freq[256] = {};
+    parallelByteHistogram((const unsigned char*)file.data(), file.size(), freq);
+    for (int c = 'a'; c <= 'z'; c++) {
+        freqMap[(char)c] += (int)(freq[c] + freq[c - 'a' + 'A']);
     }
-    file.close();
 
     cout << "\n=== 字符频率统计结果 ===" << endl;
     for (auto& pair : freqMap) {
@@ -250,6 +609,850 @@ map<char, int> countCharFrequency(const char* filename) {
     return freqMap;
 }
 
+// 往返测试与吞吐基准：按频率表随机生成 sizeMB 大小的文本，用范式编码写出“码长表头 + 位流”，
+// 解码端只从表头重建解码表，检查结果与原文一致，并报告编码 / 解码速度（MB/s）
+bool testRoundTrip(HuffTree<char>& huffTree, const map<char, int>& freqMap, int sizeMB = 16) {
+    // 按频率构造累积分布，抽样生成文本
+    Vector<char> symbols;
+    Vector<long long> cumulative;
+    long long total = 0;
+    for (auto& pair : freqMap) {
+        if (pair.second > 0) {
+            total += pair.second;
+            symbols.push_back(pair.first);
+            cumulative.push_back(total);
+        }
+    }
+    if (total == 0) return true;
+    size_t n = (size_t)sizeMB << 20;
+    string text(n, ' ');
+    Xoshiro256 rng(DEFAULT_SEED);
+    for (size_t i = 0; i < n; i++) {
+        long long r = (long long)rng.nextBelow((uint64_t)total);
+        int lo = 0, hi = symbols.size() - 1;
+        while (lo < hi) {
+            int mid = (lo + hi) / 2;
+            if (cumulative[mid] > r) hi = mid;
+            else lo = mid + 1;
+        }
+        text[i] = symbols[lo];
+    }
+
+    unsigned char lens[256];
+    huffTree.getCodeLengths(lens);
+    HuffCodeWord codes[256];
+    assignCanonicalCodes(lens, codes);
+    BitWriter out(n);
+    auto t0 = chrono::steady_clock::now();
+    writeCodeLengths(lens, out);
+    huffTree.encode(text, codes, out);
+    out.flush();
+    auto t1 = chrono::steady_clock::now();
+
+    unsigned char readLens[256];
+    BitReader in(out.data(), out.byteSize());
+    if (!readCodeLengths(in, readLens)) {
+        cout << "码长表头解析失败！" << endl;
+        return false;
+    }
+    HuffDecoder decoder;
+    decoder.buildFromLengths(readLens);
+    unsigned char* decoded = new unsigned char[n];
+    auto t2 = chrono::steady_clock::now();
+    decoder.decode(in, decoded, n);
+    auto t3 = chrono::steady_clock::now();
+
+    bool ok = memcmp(decoded, text.data(), n) == 0;
+    delete[] decoded;
+    double encSec = chrono::duration<double>(t1 - t0).count();
+    double decSec = chrono::duration<double>(t3 - t2).count();
+    cout << "\n=== 往返测试（" << sizeMB << " MB 随机文本）===" << endl;
+    cout << "解码结果：" << (ok ? "与原文一致" : "不一致！") << endl;
+    cout << "压缩后：" << out.byteSize() << " 字节（" << 8.0 * out.byteSize() / n << " 位/字符）" << endl;
+    cout << "编码速度：" << sizeMB / encSec << " MB/s，解码速度：" << sizeMB / decSec << " MB/s" << endl;
+    return ok;
+}
+
+// 建树方式对比：n 个符号（如按词编码时的大字母表）的随机权重，
+// 分别用指针树（优先队列 + new）和数组树（排序 + 双队列）建树，检查加权码长一致并比较耗时
+void compareTreeBuilds(int n) {
+    map<int, int> freqMap;
+    Vector<int> symbols;
+    Vector<uint64_t> weights;
+    Xoshiro256 rng(DEFAULT_SEED);
+    for (int i = 0; i < n; i++) {
+        int w = (int)rng.nextInt(1, 1000);
+        freqMap[i] = w;
+        symbols.push_back(i);
+        weights.push_back((uint64_t)w);
+    }
+
+    auto t0 = chrono::steady_clock::now();
+    HuffTree<int> pointerTree;
+    pointerTree.build(freqMap);
+    uint64_t pointerBits = pointerTree.totalBits();
+    auto t1 = chrono::steady_clock::now();
+    HuffArrayTree<int> arrayTree;
+    arrayTree.build(symbols.data(), weights.data(), n);
+    uint64_t arrayBits = arrayTree.totalBits();
+    auto t2 = chrono::steady_clock::now();
+
+    cout << "\n=== 建树方式对比（" << n << " 个符号）===" << endl;
+    cout << "指针树：" << chrono::duration<double, milli>(t1 - t0).count() << " ms，数组树："
+         << chrono::duration<double, milli>(t2 - t1).count() << " ms，加权码长"
+         << (pointerBits == arrayBits ? "一致" : "不一致！") << "（" << arrayBits << " 位）" << endl;
+}
+
+// ===================== 通用字节压缩器（.hufz 容器格式） =====================
+// 文件头（16 字节）：'H' 'U' 'F' 'Z'，版本号 u8，标志 u8，2 字节保留，块大小 u32，保留 u32
+// 数据块：块头（13 字节）= 原始长度 u32，负载长度 u32，原始数据 CRC-32 u32，块类型 u8，之后是负载
+//   BLOCK_STORED  负载即原始数据（不可压缩时使用）
+//   BLOCK_HUFFMAN 负载 = 码长表头 + 范式哈夫曼位流（补齐到字节）
+//   BLOCK_RLE     负载为 1 个字节，整块都是该字节
+//   BLOCK_END     结束块：原始长度 0，负载 = 原始总长度 u64，块数 u32，各块块头在文件中的偏移 u64 * 块数
+// 文件最后 8 字节为结束块块头的偏移 u64。
+// 所有整数均为小端序。每块独立统计频率、建树、编码，块之间没有依赖，
+// 因此压缩和解压都可以按块分给线程池并行处理，再按块序写出。
+const char HUFZ_MAGIC[4] = {'H', 'U', 'F', 'Z'};
+const int HUFZ_VERSION = 2; // 版本 1 没有块偏移索引，码长也不限长，不再支持
+const int HUFZ_FILE_HEADER = 16;
+const int HUFZ_BLOCK_HEADER = 13;
+const uint32_t DEFAULT_BLOCK_SIZE = 1 << 20;
+const uint32_t MAX_BLOCK_SIZE = 1 << 24; // 16 MB：保证不限长时码长也不超过 56
+const int HUFZ_FLAG_INDEXED = 1;         // 结束块带块偏移索引
+const int HUFZ_MAX_CODE_LEN = 15;        // 压缩时的码长上限（解码一级表 11 位，二级表至多 4 位）
+
+enum BlockType { BLOCK_STORED = 0, BLOCK_HUFFMAN = 1, BLOCK_RLE = 2, BLOCK_END = 0xFF };
+
+inline void putLE32(unsigned char* p, uint32_t v) {
+    for (int i = 0; i < 4; i++) p[i] = (unsigned char)(v >> (8 * i));
+}
+inline uint32_t getLE32(const unsigned char* p) {
+    return (uint32_t)p[0] | (uint32_t)p[1] << 8 | (uint32_t)p[2] << 16 | (uint32_t)p[3] << 24;
+}
+inline void putLE64(unsigned char* p, uint64_t v) {
+    for (int i = 0; i < 8; i++) p[i] = (unsigned char)(v >> (8 * i));
+}
+inline uint64_t getLE64(const unsigned char* p) {
+    return (uint64_t)getLE32(p) | (uint64_t)getLE32(p + 4) << 32;
+}
+
+// 输出到内存（bench 模式使用），与 BufferedWriter 接口一致
+struct MemorySink {
+    string buf;
+    void write(const char* p, size_t n) { buf.append(p, n); }
+};
+
+// 由字节频率求各符号码长（用 HuffArrayTree 建树）；最长码超过 maxLen 时改用 package-merge 限长，
+// 使解码时每个码字都能在一级表或一张小二级表内查到
+void buildCodeLengths(const uint64_t freq[256], unsigned char lens[256], int maxLen = HUFZ_MAX_CODE_LEN) {
+    unsigned char symbols[256];
+    for (int s = 0; s < 256; s++) symbols[s] = (unsigned char)s;
+    HuffArrayTree<unsigned char> tree;
+    tree.build(symbols, freq, 256);
+    tree.getCodeLengths(lens);
+    int longest = 0;
+    for (int s = 0; s < 256; s++) longest = max(longest, (int)lens[s]);
+    if (longest > maxLen) packageMergeLengths(freq, maxLen, lens);
+}
+
+// 限长代价报告：对比不限长哈夫曼与若干码长上限下的最长码长、平均码长和多付出的比特比例
+void reportLengthLimit(const char* name, const uint64_t freq[256]) {
+    unsigned char lens[256];
+    buildCodeLengths(freq, lens, 56);
+    double base = averageCodeLength(freq, lens);
+    int longest = 0;
+    for (int s = 0; s < 256; s++) longest = max(longest, (int)lens[s]);
+    cout << name << "：不限长 最长 " << longest << " 位，平均 " << base << " 位/符号" << endl;
+    const int limits[] = {15, 12, 10, 8};
+    for (int limit : limits) {
+        if (limit >= longest) continue;
+        if (!packageMergeLengths(freq, limit, lens)) {
+            cout << "  上限 " << limit << " 位：符号数超过 2^" << limit << "，无法限长" << endl;
+            continue;
+        }
+        double avg = averageCodeLength(freq, lens);
+        cout << "  上限 " << limit << " 位：平均 " << avg << " 位/符号，代价 +"
+             << (base > 0 ? (avg / base - 1) * 100 : 0) << "%" << endl;
+    }
+}
+
+// 压缩一个块：块头 + 负载写入 sink，scratch 为可复用的位流缓冲区
+template <typename Sink>
+void compressBlock(const unsigned char* p, size_t n, BitWriter& scratch, Sink& sink) {
+    uint64_t freq[256] = {};
+    byteHistogram(p, n, freq);
+    int distinct = 0;
+    for (int s = 0; s < 256; s++) distinct += freq[s] != 0;
+
+    unsigned char header[HUFZ_BLOCK_HEADER];
+    putLE32(header, (uint32_t)n);
+    putLE32(header + 8, crc32(p, n));
+    if (distinct == 1) {
+        putLE32(header + 4, 1);
+        header[12] = BLOCK_RLE;
+        sink.write((const char*)header, HUFZ_BLOCK_HEADER);
+        sink.write((const char*)p, 1);
+        return;
+    }
+
+    unsigned char lens[256];
+    HuffCodeWord codes[256];
+    buildCodeLengths(freq, lens);
+    assignCanonicalCodes(lens, codes);
+    uint64_t bits = 0;
+    for (int s = 0; s < 256; s++) bits += freq[s] * lens[s];
+    if (bits / 8 + 160 >= n) { // 压不下去（含表头开销），原样存储
+        putLE32(header + 4, (uint32_t)n);
+        header[12] = BLOCK_STORED;
+        sink.write((const char*)header, HUFZ_BLOCK_HEADER);
+        sink.write((const char*)p, n);
+        return;
+    }
+    scratch.clear();
+    writeCodeLengths(lens, scratch);
+    encodeBytes(p, n, codes, scratch);
+    scratch.flush();
+    putLE32(header + 4, (uint32_t)scratch.byteSize());
+    header[12] = BLOCK_HUFFMAN;
+    sink.write((const char*)header, HUFZ_BLOCK_HEADER);
+    sink.write((const char*)scratch.data(), scratch.byteSize());
+}
+
+// 压缩 [data, data + n) 为 .hufz 格式。每轮把 2 * 线程数 个块交给线程池并行压缩到各自的内存缓冲，
+// 再按块序写出并记录偏移，内存占用与总长度无关
+template <typename Sink>
+void compressStream(const unsigned char* data, uint64_t n, uint32_t blockSize, Sink& sink, int threads = 0) {
+    if (blockSize == 0 || blockSize > MAX_BLOCK_SIZE) throw runtime_error("Invalid block size");
+    unsigned char fileHeader[HUFZ_FILE_HEADER] = {};
+    memcpy(fileHeader, HUFZ_MAGIC, 4);
+    fileHeader[4] = HUFZ_VERSION;
+    fileHeader[5] = HUFZ_FLAG_INDEXED;
+    putLE32(fileHeader + 8, blockSize);
+    sink.write((const char*)fileHeader, HUFZ_FILE_HEADER);
+
+    ThreadPool pool(threads);
+    int slots = pool.size() * 2;
+    MemorySink* outs = new MemorySink[slots];
+    BitWriter* scratch = new BitWriter[pool.size()]; // 每个线程一个位流缓冲区
+    Vector<uint64_t> offsets;
+    uint64_t written = HUFZ_FILE_HEADER;
+    uint64_t blocks = (n + blockSize - 1) / blockSize;
+    for (uint64_t first = 0; first < blocks; first += slots) {
+        int cnt = (int)min<uint64_t>(slots, blocks - first);
+        pool.run(cnt, [&](int t, int worker) {
+            uint64_t pos = (first + t) * blockSize;
+            outs[t].buf.clear();
+            compressBlock(data + pos, (size_t)min<uint64_t>(blockSize, n - pos), scratch[worker], outs[t]);
+        });
+        for (int t = 0; t < cnt; t++) {
+            offsets.push_back(written);
+            sink.write(outs[t].buf.data(), outs[t].buf.size());
+            written += outs[t].buf.size();
+        }
+    }
+    delete[] outs;
+    delete[] scratch;
+
+    // 结束块 + 块偏移索引 + 结束块偏移
+    uint32_t count = offsets.size();
+    uint32_t payload = 12 + 8 * count;
+    unsigned char* end = new unsigned char[HUFZ_BLOCK_HEADER + payload + 8]();
+    putLE32(end + 4, payload);
+    end[12] = BLOCK_END;
+    putLE64(end + HUFZ_BLOCK_HEADER, n);
+    putLE32(end + HUFZ_BLOCK_HEADER + 8, count);
+    for (uint32_t i = 0; i < count; i++) putLE64(end + HUFZ_BLOCK_HEADER + 12 + 8 * i, offsets[i]);
+    putLE64(end + HUFZ_BLOCK_HEADER + payload, written);
+    sink.write((const char*)end, HUFZ_BLOCK_HEADER + payload + 8);
+    delete[] end;
+}
+
+// 解压一个块的负载到 out（out 至少 rawSize 字节），格式或校验错误时抛出异常
+void decompressBlock(const unsigned char* payload, uint32_t compSize, uint32_t rawSize,
+                     int type, uint32_t crc, unsigned char* out) {
+    if (type == BLOCK_STORED) {
+        if (compSize != rawSize) throw runtime_error("Corrupt stored block");
+        memcpy(out, payload, rawSize);
+    } else if (type == BLOCK_RLE) {
+        if (compSize != 1) throw runtime_error("Corrupt RLE block");
+        memset(out, payload[0], rawSize);
+    } else if (type == BLOCK_HUFFMAN) {
+        BitReader in(payload, compSize);
+        unsigned char lens[256];
+        if (!readCodeLengths(in, lens, HUFZ_MAX_CODE_LEN)) throw runtime_error("Corrupt code length header");
+        HuffDecoder decoder;
+        decoder.buildFromLengths(lens);
+        decoder.decode(in, out, rawSize);
+        if (in.position() > (uint64_t)compSize * 8) throw runtime_error("Truncated Huffman block");
+    } else {
+        throw runtime_error("Unknown block type");
+    }
+    if (crc32(out, rawSize) != crc) throw runtime_error("Block checksum mismatch");
+}
+
+// 解压 .hufz 数据，原始内容写入 sink，返回原始总长度。
+// 先由文件末尾找到结束块和块偏移索引，然后按轮并行解压各块，再按块序写出
+template <typename Sink>
+uint64_t decompressStream(const unsigned char* data, uint64_t n, Sink& sink, int threads = 0) {
+    if (n < HUFZ_FILE_HEADER + 8 || memcmp(data, HUFZ_MAGIC, 4) != 0) throw runtime_error("Not a .hufz stream");
+    if (data[4] == 1) throw runtime_error("Unsupported .hufz version 1 (no block index), please recompress");
+    if (data[4] != HUFZ_VERSION) throw runtime_error("Unsupported .hufz version " + to_string(data[4]));
+    if (!(data[5] & HUFZ_FLAG_INDEXED)) throw runtime_error("Missing block index");
+    uint32_t blockSize = getLE32(data + 8);
+    if (blockSize == 0 || blockSize > MAX_BLOCK_SIZE) throw runtime_error("Invalid block size");
+
+    // 结束块与索引
+    uint64_t endPos = getLE64(data + n - 8);
+    if (endPos < HUFZ_FILE_HEADER || endPos + HUFZ_BLOCK_HEADER + 12 > n - 8) throw runtime_error("Corrupt index position");
+    const unsigned char* endBlock = data + endPos;
+    uint32_t payload = getLE32(endBlock + 4);
+    if (endBlock[12] != BLOCK_END || endPos + HUFZ_BLOCK_HEADER + payload != n - 8) throw runtime_error("Corrupt end block");
+    uint64_t total = getLE64(endBlock + HUFZ_BLOCK_HEADER);
+    uint32_t count = getLE32(endBlock + HUFZ_BLOCK_HEADER + 8);
+    if (payload != 12 + 8ULL * count) throw runtime_error("Corrupt block index");
+    const unsigned char* index = endBlock + HUFZ_BLOCK_HEADER + 12;
+
+    ThreadPool pool(threads);
+    int slots = pool.size() * 2;
+    unsigned char* outs = new unsigned char[(size_t)slots * blockSize];
+    uint32_t* rawSizes = new uint32_t[slots];
+    string* errors = new string[slots];
+    uint64_t produced = 0;
+    try {
+        for (uint32_t first = 0; first < count; first += slots) {
+            int cnt = (int)min<uint32_t>(slots, count - first);
+            pool.run(cnt, [&](int t, int) {
+                try {
+                    uint64_t pos = getLE64(index + 8 * (first + t));
+                    uint64_t next = first + t + 1 < count ? getLE64(index + 8 * (first + t + 1)) : endPos;
+                    if (pos < HUFZ_FILE_HEADER || pos + HUFZ_BLOCK_HEADER > next || next > endPos) {
+                        throw runtime_error("Corrupt block offset");
+                    }
+                    const unsigned char* h = data + pos;
+                    uint32_t rawSize = getLE32(h), compSize = getLE32(h + 4);
+                    if (pos + HUFZ_BLOCK_HEADER + compSize != next) throw runtime_error("Block size does not match index");
+                    if (rawSize > blockSize) throw runtime_error("Block larger than declared block size");
+                    decompressBlock(h + HUFZ_BLOCK_HEADER, compSize, rawSize, h[12], getLE32(h + 8),
+                                    outs + (size_t)t * blockSize);
+                    rawSizes[t] = rawSize;
+                } catch (const exception& e) {
+                    errors[t] = e.what();
+                }
+            });
+            for (int t = 0; t < cnt; t++) {
+                if (!errors[t].empty()) throw runtime_error("Block " + to_string(first + t) + ": " + errors[t]);
+                sink.write((const char*)outs + (size_t)t * blockSize, rawSizes[t]);
+                produced += rawSizes[t];
+            }
+        }
+        if (produced != total) throw runtime_error("Length mismatch at end of stream");
+    } catch (...) {
+        delete[] outs;
+        delete[] rawSizes;
+        delete[] errors;
+        throw;
+    }
+    delete[] outs;
+    delete[] rawSizes;
+    delete[] errors;
+    return total;
+}
+
+// ===================== 自适应（单遍）模式（.hufa 格式） =====================
+// 编码端和解码端从同一个初始模型出发（256 个符号权重都为 1，即 8 位等长码），
+// 每处理完 segment 个字节就按相同规则更新权重并重建码表：新权重 = 旧权重 / 2 + 本段计数（至少为 1）。
+// 重建点由字节位置隐式决定，流中不需要额外的信号或码表；权重减半使模型逐渐“遗忘”旧数据，跟随日志内容变化。
+// 所有符号始终有码字，码长用 package-merge 限制在 HUFZ_MAX_CODE_LEN 以内。
+//
+// 文件头（16 字节）：'H' 'U' 'F' 'A'，版本号 u8，3 字节保留，段长 u32，保留 u32
+// 之后是若干帧，帧头与 .hufz 块头相同（原始长度 u32，负载长度 u32，CRC-32 u32，类型 u8）：
+//   BLOCK_HUFFMAN 负载为该帧字节的自适应位流（补齐到字节），BLOCK_STORED 负载为原始数据，
+//   BLOCK_END 原始长度与负载长度为 0，表示流结束。
+// 帧只是输出的切分单位（编码端读到多少就可以写出多少），模型状态跨帧延续
+const char HUFA_MAGIC[4] = {'H', 'U', 'F', 'A'};
+const int HUFA_VERSION = 1;
+const uint32_t DEFAULT_SEGMENT_SIZE = 64 << 10;
+const uint32_t MAX_SEGMENT_SIZE = 1 << 24;
+const uint32_t ADAPTIVE_FRAME_SIZE = 256 << 10;
+
+class AdaptiveHuffman {
+private:
+    uint32_t _segment;
+    uint32_t _left;        // 当前段还剩多少字节
+    uint64_t _weight[256];
+    uint64_t _seen[256];   // 当前段内的计数
+    unsigned char _lens[256];
+    HuffCodeWord _codes[256];
+    HuffDecoder _decoder;
+    bool _decoderStale;    // 码表重建后解码表尚未同步（只在解码时才建）
+
+    void rebuild() {
+        for (int s = 0; s < 256; s++) {
+            _weight[s] = max<uint64_t>(1, _weight[s] / 2 + _seen[s]);
+            _seen[s] = 0;
+        }
+        buildCodeLengths(_weight, _lens, HUFZ_MAX_CODE_LEN);
+        assignCanonicalCodes(_lens, _codes);
+        _decoderStale = true;
+        _left = _segment;
+    }
+
+    // 把已处理的 n 个字节（n 不超过本段剩余）计入模型，段满时重建
+    void account(const unsigned char* p, size_t n) {
+        byteHistogram(p, n, _seen);
+        _left -= (uint32_t)n;
+        if (_left == 0) rebuild();
+    }
+
+public:
+    AdaptiveHuffman(uint32_t segment = DEFAULT_SEGMENT_SIZE) : _segment(segment) {
+        if (segment == 0 || segment > MAX_SEGMENT_SIZE) throw runtime_error("Invalid segment size");
+        for (int s = 0; s < 256; s++) {
+            _weight[s] = 1;
+            _seen[s] = 0;
+            _lens[s] = 8;
+        }
+        assignCanonicalCodes(_lens, _codes);
+        _decoderStale = true;
+        _left = _segment;
+    }
+
+    uint32_t segmentSize() const { return _segment; }
+
+    // 编码 n 个字节写入 out（可分多次调用），返回写入的比特数
+    uint64_t encode(const unsigned char* p, size_t n, BitWriter& out) {
+        uint64_t before = out.bitCount();
+        while (n > 0) {
+            size_t take = min<size_t>(n, _left);
+            encodeBytes(p, take, _codes, out);
+            account(p, take);
+            p += take;
+            n -= take;
+        }
+        return out.bitCount() - before;
+    }
+
+    // 从 in 解出 n 个字节，与 encode 的调用方式无关
+    void decode(BitReader& in, unsigned char* out, size_t n) {
+        while (n > 0) {
+            if (_decoderStale) {
+                _decoder.buildFromLengths(_lens);
+                _decoderStale = false;
+            }
+            size_t take = min<size_t>(n, _left);
+            _decoder.decode(in, out, take);
+            account(out, take);
+            out += take;
+            n -= take;
+        }
+    }
+
+    // 不经编码直接让模型看到 n 个字节（原样存储的帧），两端据此保持同步
+    void observe(const unsigned char* p, size_t n) {
+        while (n > 0) {
+            size_t take = min<size_t>(n, _left);
+            account(p, take);
+            p += take;
+            n -= take;
+        }
+    }
+};
+
+template <typename Sink>
+void writeAdaptiveHeader(uint32_t segment, Sink& sink) {
+    unsigned char header[HUFZ_FILE_HEADER] = {};
+    memcpy(header, HUFA_MAGIC, 4);
+    header[4] = HUFA_VERSION;
+    putLE32(header + 8, segment);
+    sink.write((const char*)header, HUFZ_FILE_HEADER);
+}
+
+// 编码一帧写入 sink；n == 0 时写结束帧。位流比原始数据还长时改为原样存储
+template <typename Sink>
+void writeAdaptiveFrame(const unsigned char* p, size_t n, AdaptiveHuffman& model, BitWriter& scratch, Sink& sink) {
+    unsigned char header[HUFZ_BLOCK_HEADER] = {};
+    putLE32(header, (uint32_t)n);
+    if (n == 0) {
+        header[12] = BLOCK_END;
+        sink.write((const char*)header, HUFZ_BLOCK_HEADER);
+        return;
+    }
+    putLE32(header + 8, crc32(p, n));
+    scratch.clear();
+    model.encode(p, n, scratch);
+    scratch.flush();
+    bool stored = scratch.byteSize() >= n;
+    putLE32(header + 4, stored ? (uint32_t)n : (uint32_t)scratch.byteSize());
+    header[12] = stored ? BLOCK_STORED : BLOCK_HUFFMAN;
+    sink.write((const char*)header, HUFZ_BLOCK_HEADER);
+    if (stored) sink.write((const char*)p, n);
+    else sink.write((const char*)scratch.data(), scratch.byteSize());
+}
+
+// 单遍压缩输入流（可以是管道 / 标准输入）：每读满一帧就编码写出，不需要预先统计频率
+template <typename Sink>
+uint64_t adaptiveCompressFile(FILE* in, uint32_t segment, Sink& sink) {
+    AdaptiveHuffman model(segment);
+    BitWriter scratch(ADAPTIVE_FRAME_SIZE);
+    unsigned char* buf = new unsigned char[ADAPTIVE_FRAME_SIZE];
+    uint64_t total = 0;
+    writeAdaptiveHeader(model.segmentSize(), sink);
+    size_t got;
+    while ((got = fread(buf, 1, ADAPTIVE_FRAME_SIZE, in)) > 0) {
+        writeAdaptiveFrame(buf, got, model, scratch, sink);
+        total += got;
+    }
+    writeAdaptiveFrame(buf, 0, model, scratch, sink);
+    delete[] buf;
+    return total;
+}
+
+// 单遍压缩内存中的数据（bench 使用）
+template <typename Sink>
+void adaptiveCompress(const unsigned char* data, uint64_t n, uint32_t segment, Sink& sink) {
+    AdaptiveHuffman model(segment);
+    BitWriter scratch(ADAPTIVE_FRAME_SIZE);
+    writeAdaptiveHeader(model.segmentSize(), sink);
+    for (uint64_t pos = 0; pos < n; pos += ADAPTIVE_FRAME_SIZE) {
+        writeAdaptiveFrame(data + pos, (size_t)min<uint64_t>(ADAPTIVE_FRAME_SIZE, n - pos), model, scratch, sink);
+    }
+    writeAdaptiveFrame(data, 0, model, scratch, sink);
+}
+
+// 解压 .hufa 流，按帧顺序解码（模型跨帧延续，只能串行），返回原始总长度
+template <typename Sink>
+uint64_t adaptiveDecompress(const unsigned char* data, uint64_t n, Sink& sink) {
+    if (n < HUFZ_FILE_HEADER || memcmp(data, HUFA_MAGIC, 4) != 0) throw runtime_error("Not a .hufa stream");
+    if (data[4] != HUFA_VERSION) throw runtime_error("Unsupported .hufa version");
+    AdaptiveHuffman model(getLE32(data + 8)); // 段长非法时构造函数抛出
+    Vector<unsigned char> out;
+    uint64_t pos = HUFZ_FILE_HEADER, total = 0;
+    for (;;) {
+        if (pos + HUFZ_BLOCK_HEADER > n) throw runtime_error("Truncated .hufa stream");
+        const unsigned char* h = data + pos;
+        uint32_t rawSize = getLE32(h), compSize = getLE32(h + 4);
+        pos += HUFZ_BLOCK_HEADER;
+        if (h[12] == BLOCK_END) break;
+        if (pos + compSize > n) throw runtime_error("Truncated .hufa frame");
+        if (rawSize > ADAPTIVE_FRAME_SIZE * 64ULL) throw runtime_error("Frame too large");
+        if ((uint32_t)out.size() < rawSize) out.resize((int)rawSize);
+        if (h[12] == BLOCK_STORED) {
+            if (compSize != rawSize) throw runtime_error("Corrupt stored frame");
+            memcpy(out.data(), data + pos, rawSize);
+            model.observe(out.data(), rawSize);
+        } else if (h[12] == BLOCK_HUFFMAN) {
+            BitReader in(data + pos, compSize);
+            model.decode(in, out.data(), rawSize);
+            if (in.position() > (uint64_t)compSize * 8) throw runtime_error("Truncated Huffman frame");
+        } else {
+            throw runtime_error("Unknown frame type");
+        }
+        if (crc32(out.data(), rawSize) != getLE32(h + 8)) throw runtime_error("Frame checksum mismatch");
+        sink.write((const char*)out.data(), rawSize);
+        pos += compSize;
+        total += rawSize;
+    }
+    return total;
+}
+
+// ===================== 基准测试套件 =====================
+// 固定种子生成可复现的语料，逐块（与 .hufz 相同的块大小）分阶段计时：
+// 直方图、建码表（码长 + 范式码字 + 解码表）、编码、解码，每阶段取 BENCH_REPEAT 次中最快的一次。
+// 结果以 CSV 输出到标准输出，便于脚本比较不同版本；峰值内存取 getrusage 的 ru_maxrss（整个进程）
+const int BENCH_REPEAT = 3;
+const char* const BENCH_CORPORA[] = {"english", "random", "skewed", "repetitive"};
+
+// 生成 n 字节语料：
+//   english    按 Zipf 分布抽取常用词，句首大写，带标点和换行
+//   random     均匀随机字节（不可压缩）
+//   skewed     几何分布的字节值（约一半是 0，熵约 2 位）
+//   repetitive 一条 60 字节左右的日志模板反复出现，只有序号变化
+string generateCorpus(const string& kind, size_t n, uint64_t seed = DEFAULT_SEED) {
+    string text(n, '\0');
+    Xoshiro256 rng(seed);
+    if (kind == "random") {
+        for (size_t i = 0; i < n; i++) text[i] = (char)(rng.next() >> 56);
+    } else if (kind == "skewed") {
+        for (size_t i = 0; i < n; i++) {
+            uint64_t r = rng.next();
+            int k = 0;
+            while (k < 63 && !((r >> k) & 1)) k++; // 末尾连续 0 的个数：P(k) = 2^-(k+1)
+            text[i] = (char)k;
+        }
+    } else if (kind == "repetitive") {
+        size_t pos = 0;
+        for (long long seq = 0; pos < n; seq++) {
+            string line = "2025-01-01 12:00:00 INFO worker-3 request handled id=" + to_string(seq % 1000) + " status=200\n";
+            size_t len = min(line.size(), n - pos);
+            memcpy(&text[pos], line.data(), len);
+            pos += len;
+        }
+    } else if (kind == "english") {
+        static const char* const words[] = {
+            "the", "of", "and", "to", "a", "in", "is", "that", "for", "it", "as", "was", "with", "be", "by",
+            "on", "not", "he", "this", "are", "or", "his", "from", "at", "which", "but", "have", "an", "had",
+            "they", "you", "were", "their", "one", "all", "we", "can", "her", "has", "there", "been", "if",
+            "more", "when", "will", "would", "who", "so", "no", "dream", "freedom", "justice", "nation",
+            "today", "children", "hope", "faith", "together", "day", "land", "people", "history", "great",
+            "america", "struggle", "brotherhood", "character", "content", "mountain", "valley", "liberty"};
+        const int W = sizeof(words) / sizeof(words[0]);
+        double cdf[W], sum = 0;
+        for (int i = 0; i < W; i++) cdf[i] = (sum += 1.0 / (i + 1));
+        size_t pos = 0;
+        bool sentenceStart = true;
+        while (pos < n) {
+            double r = rng.nextDouble() * sum;
+            int w = (int)(lower_bound(cdf, cdf + W, r) - cdf);
+            string token = words[min(w, W - 1)];
+            if (sentenceStart) token[0] = (char)(token[0] - 'a' + 'A');
+            uint64_t p = rng.nextBelow(100);
+            sentenceStart = p < 8;
+            token += p < 6 ? ". " : p < 8 ? ".\n" : p < 14 ? ", " : " ";
+            size_t len = min(token.size(), n - pos);
+            memcpy(&text[pos], token.data(), len);
+            pos += len;
+        }
+    } else {
+        throw runtime_error("Unknown corpus: " + kind);
+    }
+    return text;
+}
+
+// 进程峰值常驻内存（KB），取不到时返回 0
+long peakMemoryKB() {
+#ifdef _WIN32
+    return 0;
+#else
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+#ifdef __APPLE__
+    return usage.ru_maxrss / 1024; // macOS 以字节为单位
+#else
+    return usage.ru_maxrss;
+#endif
+#endif
+}
+
+// 对一份语料分阶段计时，输出一行 CSV
+bool benchCorpus(const string& name, const string& text, uint32_t blockSize) {
+    const unsigned char* data = (const unsigned char*)text.data();
+    size_t n = text.size();
+    size_t blocks = (n + blockSize - 1) / blockSize;
+    Vector<uint64_t> freq;
+    freq.resize((int)(blocks * 256));
+    Vector<unsigned char> lens;
+    lens.resize((int)(blocks * 256));
+    HuffDecoder* decoders = new HuffDecoder[blocks];
+    BitWriter* streams = new BitWriter[blocks];
+    unsigned char* decoded = new unsigned char[n];
+    double best[4] = {1e30, 1e30, 1e30, 1e30}; // 直方图、建码表、编码、解码
+    bool headersOk = true; // 每块写出的码长表都能读回且与建出的码长一致
+
+    for (int rep = 0; rep < BENCH_REPEAT; rep++) {
+        auto t0 = chrono::steady_clock::now();
+        memset(freq.data(), 0, sizeof(uint64_t) * 256 * blocks);
+        for (size_t b = 0; b < blocks; b++) {
+            size_t lo = b * blockSize, len = min<size_t>(blockSize, n - lo);
+            byteHistogram(data + lo, len, freq.data() + 256 * b);
+        }
+        auto t1 = chrono::steady_clock::now();
+        HuffCodeWord codes[256];
+        for (size_t b = 0; b < blocks; b++) {
+            unsigned char* l = lens.data() + 256 * b;
+            buildCodeLengths(freq.data() + 256 * b, l);
+            decoders[b].buildFromLengths(l);
+        }
+        auto t2 = chrono::steady_clock::now();
+        for (size_t b = 0; b < blocks; b++) {
+            size_t lo = b * blockSize, len = min<size_t>(blockSize, n - lo);
+            const unsigned char* l = lens.data() + 256 * b;
+            assignCanonicalCodes(l, codes);
+            streams[b].clear();
+            writeCodeLengths(l, streams[b]);
+            encodeBytes(data + lo, len, codes, streams[b]);
+            streams[b].flush();
+        }
+        auto t3 = chrono::steady_clock::now();
+        for (size_t b = 0; b < blocks; b++) {
+            size_t lo = b * blockSize, len = min<size_t>(blockSize, n - lo);
+            unsigned char l[256];
+            BitReader in(streams[b].data(), streams[b].byteSize());
+            if (!readCodeLengths(in, l, HUFZ_MAX_CODE_LEN) || memcmp(l, lens.data() + 256 * b, 256) != 0) {
+                headersOk = false;
+                continue;
+            }
+            decoders[b].decode(in, decoded + lo, len);
+        }
+        auto t4 = chrono::steady_clock::now();
+        chrono::steady_clock::time_point t[5] = {t0, t1, t2, t3, t4};
+        for (int k = 0; k < 4; k++) best[k] = min(best[k], chrono::duration<double>(t[k + 1] - t[k]).count());
+    }
+
+    uint64_t packed = 0;
+    for (size_t b = 0; b < blocks; b++) packed += streams[b].byteSize();
+    bool ok = headersOk && memcmp(decoded, data, n) == 0;
+    double mb = n / 1e6;
+    cout << name << "," << n << "," << packed << "," << (n ? (double)packed / n : 0);
+    for (int k = 0; k < 4; k++) cout << "," << mb / max(best[k], 1e-9);
+    cout << "," << peakMemoryKB() << "," << (ok ? "ok" : "FAIL") << endl;
+
+    delete[] decoded;
+    delete[] streams;
+    delete[] decoders;
+    return ok;
+}
+
+// 在全部语料上运行基准测试（单线程，sizeMB 为每份语料的大小）
+bool runBenchSuite(int sizeMB, uint32_t blockSize = DEFAULT_BLOCK_SIZE) {
+    cout << "corpus,bytes,compressed,ratio,histogram_mbps,build_mbps,encode_mbps,decode_mbps,peak_rss_kb,roundtrip" << endl;
+    bool ok = true;
+    for (const char* kind : BENCH_CORPORA) {
+        string text = generateCorpus(kind, (size_t)sizeMB << 20);
+        ok = benchCorpus(kind, text, blockSize) && ok;
+    }
+    return ok;
+}
+
+// 命令执行失败时关闭输出并删掉写了一半的文件；只删除普通文件，标准输出和设备文件（如 /dev/null）不动
+void discardOutput(BufferedWriter& out, const char* path) {
+    out.close();
+    struct stat st;
+    if (strcmp(path, "-") != 0 && stat(path, &st) == 0 && S_ISREG(st.st_mode)) remove(path);
+}
+
+// 命令行：exp2 compress <输入> <输出> [块大小KB] | decompress <输入> <输出> | bench <输入> [块大小KB]
+//         | acompress <输入|-> <输出> [段长KB] | adecompress <输入> <输出> | suite [每份语料MB] [块大小KB]
+// 线程数由环境变量 HUFZ_THREADS 指定，缺省使用全部硬件线程
+int runCommand(int argc, char* argv[]) {
+    string mode = argv[1];
+    const char* threadEnv = getenv("HUFZ_THREADS");
+    int threads = threadEnv ? atoi(threadEnv) : 0;
+    try {
+        if ((mode == "compress" || mode == "decompress") && argc >= 4) {
+            MappedFile in;
+            if (!in.open(argv[2])) throw runtime_error(string("Cannot open ") + argv[2]);
+            BufferedWriter out(4 << 20);
+            if (!out.open(argv[3])) throw runtime_error(string("Cannot create ") + argv[3]);
+            const unsigned char* data = (const unsigned char*)in.data();
+            auto t0 = chrono::steady_clock::now();
+            uint64_t rawBytes;
+            try {
+                if (mode == "compress") {
+                    uint32_t blockSize = argc >= 5 ? (uint32_t)atoi(argv[4]) << 10 : DEFAULT_BLOCK_SIZE;
+                    compressStream(data, in.size(), blockSize, out, threads);
+                    rawBytes = in.size();
+                } else {
+                    rawBytes = decompressStream(data, in.size(), out, threads);
+                }
+                if (!out.close()) throw runtime_error(string("Write failed: ") + argv[3]);
+            } catch (...) {
+                discardOutput(out, argv[3]);
+                throw;
+            }
+            double sec = chrono::duration<double>(chrono::steady_clock::now() - t0).count();
+            cerr << mode << "：" << rawBytes << " 字节，耗时 " << sec << " s，"
+                 << rawBytes / 1e6 / sec << " MB/s" << endl;
+            return 0;
+        }
+        if (mode == "acompress" && argc >= 4) {
+            long long segmentKB = argc >= 5 ? atoll(argv[4]) : DEFAULT_SEGMENT_SIZE >> 10;
+            if (segmentKB <= 0 || segmentKB > (MAX_SEGMENT_SIZE >> 10)) throw runtime_error("Invalid segment size");
+            uint32_t segment = (uint32_t)segmentKB << 10;
+            FILE* in = string(argv[2]) == "-" ? stdin : fopen(argv[2], "rb");
+            if (!in) throw runtime_error(string("Cannot open ") + argv[2]);
+            BufferedWriter out(4 << 20);
+            if (!out.open(argv[3])) {
+                if (in != stdin) fclose(in);
+                throw runtime_error(string("Cannot create ") + argv[3]);
+            }
+            auto t0 = chrono::steady_clock::now();
+            uint64_t rawBytes;
+            try {
+                rawBytes = adaptiveCompressFile(in, segment, out);
+                if (in != stdin) fclose(in);
+                in = nullptr;
+                if (!out.close()) throw runtime_error(string("Write failed: ") + argv[3]);
+            } catch (...) {
+                if (in && in != stdin) fclose(in);
+                discardOutput(out, argv[3]);
+                throw;
+            }
+            double sec = chrono::duration<double>(chrono::steady_clock::now() - t0).count();
+            cerr << mode << "：" << rawBytes << " 字节，耗时 " << sec << " s，" << rawBytes / 1e6 / sec << " MB/s" << endl;
+            return 0;
+        }
+        if (mode == "adecompress" && argc >= 4) {
+            MappedFile in;
+            if (!in.open(argv[2])) throw runtime_error(string("Cannot open ") + argv[2]);
+            BufferedWriter out(4 << 20);
+            if (!out.open(argv[3])) throw runtime_error(string("Cannot create ") + argv[3]);
+            auto t0 = chrono::steady_clock::now();
+            uint64_t rawBytes;
+            try {
+                rawBytes = adaptiveDecompress((const unsigned char*)in.data(), in.size(), out);
+                if (!out.close()) throw runtime_error(string("Write failed: ") + argv[3]);
+            } catch (...) {
+                discardOutput(out, argv[3]);
+                throw;
+            }
+            double sec = chrono::duration<double>(chrono::steady_clock::now() - t0).count();
+            cerr << mode << "：" << rawBytes << " 字节，耗时 " << sec << " s，" << rawBytes / 1e6 / sec << " MB/s" << endl;
+            return 0;
+        }
+        if (mode == "suite") {
+            int sizeMB = argc >= 3 ? atoi(argv[2]) : 32;
+            uint32_t blockSize = argc >= 4 ? (uint32_t)atoi(argv[3]) << 10 : DEFAULT_BLOCK_SIZE;
+            if (sizeMB <= 0 || blockSize == 0 || blockSize > MAX_BLOCK_SIZE) throw runtime_error("Invalid suite size");
+            return runBenchSuite(sizeMB, blockSize) ? 0 : 1;
+        }
+        if (mode == "bench" && argc >= 3) {
+            MappedFile in;
+            if (!in.open(argv[2])) throw runtime_error(string("Cannot open ") + argv[2]);
+            uint32_t blockSize = argc >= 4 ? (uint32_t)atoi(argv[3]) << 10 : DEFAULT_BLOCK_SIZE;
+            const unsigned char* data = (const unsigned char*)in.data();
+            MemorySink packed, unpacked;
+            auto t0 = chrono::steady_clock::now();
+            compressStream(data, in.size(), blockSize, packed, threads);
+            auto t1 = chrono::steady_clock::now();
+            decompressStream((const unsigned char*)packed.buf.data(), packed.buf.size(), unpacked, threads);
+            auto t2 = chrono::steady_clock::now();
+            bool ok = unpacked.buf.size() == in.size() && memcmp(unpacked.buf.data(), data, in.size()) == 0;
+            double mb = in.size() / 1e6;
+            cout << "原始 " << in.size() << " 字节 -> 压缩 " << packed.buf.size() << " 字节（"
+                 << (in.size() ? 100.0 * packed.buf.size() / in.size() : 0) << "%）" << endl;
+            cout << "压缩 " << mb / chrono::duration<double>(t1 - t0).count() << " MB/s，解压 "
+                 << mb / chrono::duration<double>(t2 - t1).count() << " MB/s，往返校验："
+                 << (ok ? "通过" : "失败") << endl;
+
+            // 对比：单遍自适应模式（单线程、无需预先统计）
+            MemorySink apacked, aunpacked;
+            auto t3 = chrono::steady_clock::now();
+            adaptiveCompress(data, in.size(), DEFAULT_SEGMENT_SIZE, apacked);
+            auto t4 = chrono::steady_clock::now();
+            adaptiveDecompress((const unsigned char*)apacked.buf.data(), apacked.buf.size(), aunpacked);
+            auto t5 = chrono::steady_clock::now();
+            bool aok = aunpacked.buf.size() == in.size() && memcmp(aunpacked.buf.data(), data, in.size()) == 0;
+            cout << "自适应（段长 " << (DEFAULT_SEGMENT_SIZE >> 10) << " KB）-> 压缩 " << apacked.buf.size() << " 字节（"
+                 << (in.size() ? 100.0 * apacked.buf.size() / in.size() : 0) << "%）" << endl;
+            cout << "压缩 " << mb / chrono::duration<double>(t4 - t3).count() << " MB/s，解压 "
+                 << mb / chrono::duration<double>(t5 - t4).count() << " MB/s，往返校验："
+                 << (aok ? "通过" : "失败") << endl;
+            return ok && aok ? 0 : 1;
+        }
+    } catch (const exception& e) {
+        cerr << "Error: " << e.what() << endl;
+        return 1;
+    }
+    cerr << "用法：" << argv[0] << " compress <输入> <输出> [块大小KB]" << endl
+         << "      " << argv[0] << " decompress <输入> <输出>" << endl
+         << "      " << argv[0] << " acompress <输入|-> <输出> [段长KB]   （单遍自适应）" << endl
+         << "      " << argv[0] << " adecompress <输入> <输出>" << endl
+         << "      " << argv[0] << " bench <输入> [块大小KB]" << endl
+         << "      " << argv[0] << " suite [每份语料MB] [块大小KB]   （生成语料的分阶段基准，CSV 输出）" << endl;
+    return 2;
+}
+
 // 本地定义遍历函数（避免依赖库中的重复定义）
 template <typename T>
 void printElem(T& e) {
@@ -263,7 +1466,9 @@ struct Inc {
     }
 };
 
-int main() {
+int main(int argc, char* argv[]) {
+    if (argc >= 2) return runCommand(argc, argv);
+
     cout << "===== 哈夫曼编码实验（exp2）=====" << endl;
 
     // 1. 统计字符频率
@@ -280,25 +1485,73 @@ int main() {
         cout << pair.first << ": " << pair.second << "（长度：" << pair.second.size() << "）" << endl;
     }
 
+    // 范式编码：码长不变，码字只由码长决定，表头只需保存码长
+    map<char, string> canonMap = huffTree.getCanonicalCodeMap();
+    unsigned char lens[256];
+    huffTree.getCodeLengths(lens);
+    BitWriter header;
+    writeCodeLengths(lens, header);
+    header.flush();
+    cout << "\n=== 范式哈夫曼编码（表头 " << header.byteSize() << " 字节）===" << endl;
+    for (auto& pair : canonMap) {
+        cout << pair.first << ": " << pair.second << "  ";
+    }
+    cout << endl;
+
+    // 平均码长与熵的对比：实际输出位数应接近熵下界
+    double total = 0, codedBits = 0;
+    for (auto& pair : freqMap) {
+        total += pair.second;
+        codedBits += (double)pair.second * codeMap[pair.first].size();
+    }
+    if (total > 0) {
+        cout << "\n平均码长：" << codedBits / total << " 位/字符，熵下界："
+             << entropyBitsPerSymbol(freqMap) << " 位/字符" << endl;
+    }
+
     // 4. 测试单词编码
     cout << "\n=== 单词编码测试 ===" << endl;
     string testWords[] = {"dream", "freedom", "justice", "hope", "ihaveadream", "america"};
     for (string word : testWords) {
-        string encoded = huffTree.encode(word, codeMap);
-        double compressionRate = huffTree.calculateCompressionRate(word, encoded);
-        cout << word << " -> " << encoded 
-             << "（长度：" << encoded.size() << "，压缩率：" << compressionRate << "%" << "）" << endl;
+        BitWriter out;
+        uint64_t bits = huffTree.encode(word, codeMap, out);
+        out.flush();
+        double compressionRate = huffTree.calculateCompressionRate(word.size(), out.byteSize());
+        cout << word << " -> " << bitsToString(out.data(), bits)
+             << "（" << bits << " 位，" << out.byteSize() << " 字节，压缩率：" << compressionRate << "%" << "）" << endl;
     }
 
-    // 5. 自定义输入编码
+    // 5. 往返测试与解码吞吐
+    testRoundTrip(huffTree, freqMap);
+
+    // 6. 限长编码的代价：正常文本几乎不受影响，极度偏斜（斐波那契权重）的分布码长可达 30 位以上
+    cout << "\n=== 限长哈夫曼（package-merge）===" << endl;
+    uint64_t letterFreq[256] = {}, skewed[256] = {};
+    for (auto& pair : freqMap) letterFreq[(unsigned char)pair.first] = (uint64_t)pair.second;
+    reportLengthLimit("字母频率", letterFreq);
+    uint64_t a = 1, b = 1;
+    for (int s = 0; s < 40; s++) {
+        skewed[s] = a;
+        uint64_t c = a + b;
+        a = b;
+        b = c;
+    }
+    reportLengthLimit("斐波那契权重（40 个符号）", skewed);
+
+    // 7. 大字母表下两种建树方式的对比
+    compareTreeBuilds(1 << 20);
+
+    // 8. 自定义输入编码
     cout << "\n=== 自定义输入编码 ===" << endl;
     string input;
     cout << "请输入要编码的字符串（仅处理字母）：";
     cin >> input;
-    string customEncoded = huffTree.encode(input, codeMap);
-    double customRate = huffTree.calculateCompressionRate(input, customEncoded);
-    cout << input << " -> " << customEncoded 
-         << "（长度：" << customEncoded.size() << "，压缩率：" << customRate << "%" << "）" << endl;
+    BitWriter customOut;
+    uint64_t customBits = huffTree.encode(input, codeMap, customOut);
+    customOut.flush();
+    double customRate = huffTree.calculateCompressionRate(input.size(), customOut.byteSize());
+    cout << input << " -> " << bitsToString(customOut.data(), customBits)
+         << "（" << customBits << " 位，" << customOut.byteSize() << " 字节，压缩率：" << customRate << "%" << "）" << endl;
 
     cout << "\n===== 实验结束 =====" << endl;
     return 0;
@@ -1,239 +1,1318 @@
 #include "MySTL/Vector.h"
 #include "MySTL/list.h"
 #include "MySTL/Stack.h"
+#include "MySTL/IndexedHeap.h"
+#include "MySTL/UnionFind.h"
+#include "MySTL/StringInterner.h"
+#include "MySTL/Parallel.h"
+#include "MySTL/Bitmap.h"
+#include "MySTL/FileIO.h"
 #include <iostream>
 #include <climits>
 #include <cstring>
 #include <map>
+#include <string_view>
+#include <chrono>
+#include <stdexcept>
+#include <atomic>
+#include <cstdint>
+#include "MySTL/Random.h"
 using namespace std;
 
-// 确保Queue基于List实现（若List.h中未定义，补充以下代码）
-template <typename T>
-class Queue {
+// 边：u - v，权重 w（有向图中表示 u -> v）
+struct Edge {
+    int u, v;
+    int w;
+};
+
+// CSR 二进制快照：64 字节文件头后依次是 offset / adj / weight 三个数组的原始字节（各自 8 字节对齐），
+// 按主机字节序写出，读回时直接 mmap，数组指针指向映射区，不做任何解析
+const char CSR_MAGIC[4] = {'C', 'S', 'R', 'G'};
+const uint32_t CSR_VERSION = 1;
+const uint32_t CSR_BYTE_ORDER = 0x01020304; // 读回不等说明快照来自字节序不同的机器
+
+struct CSRSnapshotHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t byteOrder;
+    uint32_t directed;
+    uint64_t n;          // 顶点数
+    uint64_t m;          // 弧数
+    uint64_t offsetPos;  // 各数组在文件中的字节位置
+    uint64_t adjPos;
+    uint64_t weightPos;
+    uint64_t fileSize;   // 用于发现截断的文件
+};
+
+// 压缩稀疏行（CSR）存储：顶点 u 的出边为下标 [offset[u], offset[u + 1]) 内的 adj / weight，
+// 共 O(V + E) 空间，访问一个顶点的邻居只扫描它自己的边，不再扫描整行矩阵
+class CSRGraph {
 private:
-    List<T> list;
+    int _n;
+    long long _m;        // 弧数（无向边存成两条方向相反的弧）
+    long long* _offset;  // n + 1 项
+    int* _adj;           // 弧的终点
+    int* _weight;        // 弧的权重
+    bool _directed;
+    MappedFile _file;    // 从快照载入时三个数组都指向这里的只读映射区，不归本对象释放
+
+    void release() {
+        if (_file.isOpen()) {
+            _file.close();
+        } else {
+            delete[] _offset;
+            delete[] _adj;
+            delete[] _weight;
+        }
+        _offset = nullptr;
+        _adj = nullptr;
+        _weight = nullptr;
+        _n = 0;
+        _m = 0;
+    }
+
 public:
-    void enqueue(const T& e) { list.insertAsLast(e); }
-    T dequeue() { return list.remove(list.first()); }
-    T front() { return list.first()->data; }
-    bool empty() { return list.empty(); }
+    CSRGraph() : _n(0), _m(0), _offset(nullptr), _adj(nullptr), _weight(nullptr), _directed(false) {}
+    ~CSRGraph() { release(); }
+
+    CSRGraph(const CSRGraph&) = delete;
+    CSRGraph& operator=(const CSRGraph&) = delete;
+
+    // 由边表建图（O(V + E)）：两趟计数排序，先按终点、再稳定地按起点分配，
+    // 结果每个顶点的邻居按编号递增（重边保持加入顺序）。无向图的自环只存一条弧
+    void build(int n, const Edge* edges, long long m, bool directed = false) {
+        release();
+        _n = n;
+        _directed = directed;
+        for (long long i = 0; i < m; i++) {
+            if (edges[i].u < 0 || edges[i].u >= n || edges[i].v < 0 || edges[i].v >= n) {
+                throw runtime_error("Edge endpoint out of range");
+            }
+        }
+        long long arcs = 0;
+        for (long long i = 0; i < m; i++) arcs += (directed || edges[i].u == edges[i].v) ? 1 : 2;
+        _m = arcs;
+
+        // 第一趟：按终点计数并分配到临时数组
+        long long* count = new long long[(size_t)n + 1];
+        int* tmpSrc = new int[arcs];
+        int* tmpDst = new int[arcs];
+        int* tmpW = new int[arcs];
+        memset(count, 0, sizeof(long long) * ((size_t)n + 1));
+        for (long long i = 0; i < m; i++) {
+            count[edges[i].v + 1]++;
+            if (!directed && edges[i].u != edges[i].v) count[edges[i].u + 1]++;
+        }
+        for (int v = 0; v < n; v++) count[v + 1] += count[v];
+        for (long long i = 0; i < m; i++) {
+            const Edge& e = edges[i];
+            long long k = count[e.v]++;
+            tmpSrc[k] = e.u, tmpDst[k] = e.v, tmpW[k] = e.w;
+            if (!directed && e.u != e.v) {
+                k = count[e.u]++;
+                tmpSrc[k] = e.v, tmpDst[k] = e.u, tmpW[k] = e.w;
+            }
+        }
+
+        // 第二趟：按起点稳定分配，得到 offset / adj / weight
+        _offset = new long long[(size_t)n + 1];
+        _adj = new int[arcs];
+        _weight = new int[arcs];
+        memset(_offset, 0, sizeof(long long) * ((size_t)n + 1));
+        for (long long k = 0; k < arcs; k++) _offset[tmpSrc[k] + 1]++;
+        for (int u = 0; u < n; u++) _offset[u + 1] += _offset[u];
+        memcpy(count, _offset, sizeof(long long) * ((size_t)n + 1));
+        for (long long k = 0; k < arcs; k++) {
+            long long pos = count[tmpSrc[k]]++;
+            _adj[pos] = tmpDst[k];
+            _weight[pos] = tmpW[k];
+        }
+        delete[] tmpW;
+        delete[] tmpDst;
+        delete[] tmpSrc;
+        delete[] count;
+    }
+
+    int vertexCount() const { return _n; }
+    long long arcCount() const { return _m; }
+    bool directed() const { return _directed; }
+
+    // 顶点 u 的出弧下标区间 [begin(u), end(u))
+    long long begin(int u) const { return _offset[u]; }
+    long long end(int u) const { return _offset[u + 1]; }
+    long long degree(int u) const { return _offset[u + 1] - _offset[u]; }
+    int target(long long e) const { return _adj[e]; }
+    int weight(long long e) const { return _weight[e]; }
+
+    // 底层数组（供批量算法直接读取）
+    const long long* offsets() const { return _offset; }
+    const int* neighbors() const { return _adj; }
+    const int* weights() const { return _weight; }
+
+    // 占用的字节数
+    size_t memoryBytes() const {
+        return sizeof(long long) * ((size_t)_n + 1) + (sizeof(int) * 2) * (size_t)_m;
+    }
+
+    // 数组是否来自快照的内存映射
+    bool mapped() const { return _file.isOpen(); }
+
+    // 写出二进制快照，无法创建文件或写入失败（如磁盘已满）时返回 false
+    bool saveSnapshot(const char* path) const {
+        BufferedWriter out(4 << 20);
+        if (!out.open(path)) return false;
+        uint64_t offsetBytes = sizeof(long long) * ((uint64_t)_n + 1);
+        uint64_t arcBytes = sizeof(int) * (uint64_t)_m;
+        uint64_t arcPadded = (arcBytes + 7) / 8 * 8;
+        CSRSnapshotHeader h;
+        memset(&h, 0, sizeof(h));
+        memcpy(h.magic, CSR_MAGIC, 4);
+        h.version = CSR_VERSION;
+        h.byteOrder = CSR_BYTE_ORDER;
+        h.directed = _directed ? 1 : 0;
+        h.n = (uint64_t)_n;
+        h.m = (uint64_t)_m;
+        h.offsetPos = sizeof(CSRSnapshotHeader);
+        h.adjPos = h.offsetPos + offsetBytes;
+        h.weightPos = h.adjPos + arcPadded;
+        h.fileSize = h.weightPos + arcPadded;
+        const char zeros[8] = {0};
+        out.write((const char*)&h, sizeof(h));
+        out.write((const char*)_offset, offsetBytes);
+        out.write((const char*)_adj, arcBytes);
+        out.write(zeros, arcPadded - arcBytes);
+        out.write((const char*)_weight, arcBytes);
+        out.write(zeros, arcPadded - arcBytes);
+        return out.close();
+    }
+
+    // 映射并载入快照：不解析、不复制，数组直接指向映射区。校验文件头之后再并行顺序扫一遍
+    // offset 是否单调、每个 adj 是否在 [0, n) 内（与 build() 拒绝越界端点同等严格，1 亿条边不到 1 秒），
+    // 损坏的快照不会让后续算法越界访问。无法打开返回 false，格式 / 版本 / 内容不符抛出异常
+    bool loadSnapshot(const char* path, int threads = 0) {
+        release();
+        if (!_file.open(path, false)) return false;
+        const char* base = _file.data();
+        uint64_t size = _file.size();
+        CSRSnapshotHeader h;
+        if (size < sizeof(h)) throw runtime_error("Graph snapshot is truncated");
+        memcpy(&h, base, sizeof(h));
+        if (memcmp(h.magic, CSR_MAGIC, 4) != 0) throw runtime_error("Not a graph snapshot");
+        if (h.version != CSR_VERSION) throw runtime_error("Unsupported graph snapshot version");
+        if (h.byteOrder != CSR_BYTE_ORDER) throw runtime_error("Graph snapshot has different byte order");
+        if (h.n > (uint64_t)INT_MAX || h.m > size / sizeof(int)) throw runtime_error("Graph snapshot is corrupted");
+        uint64_t arcPadded = (sizeof(int) * h.m + 7) / 8 * 8;
+        if (h.fileSize != size ||
+            h.offsetPos != sizeof(h) || h.adjPos != h.offsetPos + sizeof(long long) * (h.n + 1) ||
+            h.weightPos != h.adjPos + arcPadded || h.fileSize != h.weightPos + arcPadded) {
+            throw runtime_error("Graph snapshot is corrupted");
+        }
+        const long long* offset = (const long long*)(base + h.offsetPos);
+        const int* adj = (const int*)(base + h.adjPos);
+        if (offset[0] != 0 || offset[h.n] != (long long)h.m) throw runtime_error("Graph snapshot is corrupted");
+        atomic<bool> bad(false);
+        int n = (int)h.n;
+        parallelFor(n, threads, [&](int, long long lo, long long hi) {
+            for (long long u = lo; u < hi && !bad.load(memory_order_relaxed); u++) {
+                long long b = offset[u], e = offset[u + 1];
+                if (b > e || b < 0 || e > (long long)h.m) {
+                    bad = true;
+                    break;
+                }
+                for (long long k = b; k < e; k++) {
+                    if ((unsigned)adj[k] >= (unsigned)n) {
+                        bad = true;
+                        break;
+                    }
+                }
+            }
+        });
+        if (bad) throw runtime_error("Graph snapshot is corrupted");
+        _n = (int)h.n;
+        _m = (long long)h.m;
+        _directed = h.directed != 0;
+        _offset = (long long*)(base + h.offsetPos); // 只读映射，本类建好后不再写这些数组
+        _adj = (int*)(base + h.adjPos);
+        _weight = (int*)(base + h.weightPos);
+        return true;
+    }
 };
 
-class Graph {
-private:
-    int vertexNum;
-    Vector<Vector<int>> adj;
-    Vector<string> vertexs;
-    map<string, int> vtxMap;
+// 边表文本：每行 "u v [w]"（空格或制表符分隔，w 缺省为 1），顶点编号从 0 开始，
+// 以 # 或 % 开头的行（SNAP / Matrix Market 的注释）和空行被跳过，兼容 \r\n 换行
+inline bool parseEdgeField(const char*& p, const char* end, long long& x) {
+    while (p < end && (*p == ' ' || *p == '\t')) p++;
+    bool neg = false;
+    if (p < end && (*p == '-' || *p == '+')) neg = *p++ == '-';
+    if (p == end || (unsigned)(*p - '0') > 9) return false;
+    long long v = 0;
+    while (p < end && (unsigned)(*p - '0') <= 9) {
+        v = v * 10 + (*p++ - '0');
+        if (v > (long long)INT_MAX + 1) return false;
+    }
+    x = neg ? -v : v;
+    return x >= INT_MIN && x <= INT_MAX;
+}
 
-    void dfsHelper(int u, Vector<bool>& visited) {
-        cout << vertexs[u] << " ";
-        // 修复：自定义Vector的[]返回值需匹配类型
-        visited.replace(u, true);
-        for (int v = 0; v < vertexNum; v++) {
-            if (adj[u][v] != INT_MAX && !visited[v]) {
-                dfsHelper(v, visited);
+// 解析 [p, end) 这一行（不含 \n）：得到一条边返回 1，注释 / 空行返回 0，格式错误返回 -1
+inline int parseEdgeLine(const char* p, const char* end, Edge& e) {
+    while (p < end && (*p == ' ' || *p == '\t' || *p == '\r')) p++;
+    if (p == end || *p == '#' || *p == '%') return 0;
+    long long u, v, w = 1;
+    if (!parseEdgeField(p, end, u) || !parseEdgeField(p, end, v)) return -1;
+    if (u < 0 || v < 0 || u >= INT_MAX || v >= INT_MAX) return -1;
+    while (p < end && (*p == ' ' || *p == '\t' || *p == '\r')) p++;
+    if (p < end) {
+        if (!parseEdgeField(p, end, w)) return -1;
+        while (p < end && (*p == ' ' || *p == '\t' || *p == '\r')) p++;
+        if (p < end) return -1;
+    }
+    e.u = (int)u, e.v = (int)v, e.w = (int)w;
+    return 1;
+}
+
+// 并行解析内存中的边表文本并建 CSR，顶点数取最大编号 + 1，返回边数。
+//   1. 把文本按字节均分成 threads 块，块边界后移到下一个行首，各块统计换行数；
+//   2. 前缀和给每块分配边数组中的槽位和起始行号，各块独立解析写入自己的槽位；
+//   3. 按块顺序压紧（注释行留下的空槽），结果与串行逐行读入的边序完全相同。
+// 格式错误时抛出异常，报告第一处错误的行号
+long long parseEdgeList(const char* data, size_t size, CSRGraph& g, bool directed = false, int threads = 0) {
+    int chunks = resolveThreads(threads);
+    if ((size_t)chunks > size / 4096 + 1) chunks = (int)(size / 4096 + 1); // 小文件不值得切分
+    Vector<long long> start, lines, slot, count, errLine;
+    Vector<int> maxId;
+    start.resize(chunks + 1);
+    lines.resize(chunks);
+    slot.resize(chunks + 1);
+    count.resize(chunks);
+    errLine.resize(chunks);
+    maxId.resize(chunks);
+    start[0] = 0;
+    start[chunks] = (long long)size;
+    for (int c = 1; c < chunks; c++) {
+        const char* nl = (const char*)memchr(data + size * c / chunks, '\n', size - size * c / chunks);
+        long long pos = nl ? nl - data + 1 : (long long)size;
+        start[c] = pos > start[c - 1] ? pos : start[c - 1];
+    }
+
+    // 1. 各块的换行数（最后一行可能没有换行符，因此槽位数按换行数 + 1 预留）
+    parallelFor(chunks, chunks, [&](int, long long lo, long long hi) {
+        for (int c = (int)lo; c < hi; c++) {
+            long long nl = 0;
+            const char* p = data + start[c];
+            const char* end = data + start[c + 1];
+            while ((p = (const char*)memchr(p, '\n', end - p)) != nullptr) {
+                nl++;
+                p++;
+            }
+            lines[c] = nl;
+        }
+    });
+    slot[0] = 0;
+    for (int c = 0; c < chunks; c++) slot[c + 1] = slot[c] + lines[c] + 1;
+    Edge* edges = new Edge[slot[chunks] > 0 ? slot[chunks] : 1];
+
+    // 2. 并行解析，行号 = 之前各块的换行数之和 + 块内行序
+    parallelFor(chunks, chunks, [&](int, long long lo, long long hi) {
+        for (int c = (int)lo; c < hi; c++) {
+            long long line = 1;
+            for (int k = 0; k < c; k++) line += lines[k];
+            const char* p = data + start[c];
+            const char* end = data + start[c + 1];
+            Edge* out = edges + slot[c];
+            long long k = 0;
+            int top = -1;
+            errLine[c] = -1;
+            while (p < end) {
+                const char* nl = (const char*)memchr(p, '\n', end - p);
+                const char* eol = nl ? nl : end;
+                int r = parseEdgeLine(p, eol, out[k]);
+                if (r < 0) {
+                    errLine[c] = line;
+                    break;
+                }
+                if (r > 0) {
+                    if (out[k].u > top) top = out[k].u;
+                    if (out[k].v > top) top = out[k].v;
+                    k++;
+                }
+                p = eol + 1;
+                line++;
             }
+            count[c] = k;
+            maxId[c] = top;
+        }
+    });
+    for (int c = 0; c < chunks; c++) {
+        if (errLine[c] >= 0) {
+            delete[] edges;
+            throw runtime_error("Malformed edge list at line " + to_string(errLine[c]));
         }
     }
 
-    void tarjan(int u, int parent, Vector<int>& dfn, Vector<int>& low, 
-                Vector<bool>& isCut, int& time) {
-        dfn.replace(u, ++time);
-        low.replace(u, dfn[u]);
-        int childCount = 0;
-        for (int v = 0; v < vertexNum; v++) {
-            if (adj[u][v] == INT_MAX) continue;
-            if (dfn[v] == 0) {
-                childCount++;
-                tarjan(v, u, dfn, low, isCut, time);
-                if (low[v] < low[u]) low.replace(u, low[v]);
-                if (parent == -1 && childCount > 1) isCut.replace(u, true);
-                if (parent != -1 && low[v] >= dfn[u]) isCut.replace(u, true);
-            } else if (v != parent && dfn[v] < low[u]) {
-                low.replace(u, dfn[v]);
+    // 3. 压紧并建图
+    long long m = 0;
+    int top = -1;
+    for (int c = 0; c < chunks; c++) {
+        if (m != slot[c]) memmove(edges + m, edges + slot[c], sizeof(Edge) * count[c]);
+        m += count[c];
+        if (maxId[c] > top) top = maxId[c];
+    }
+    try {
+        g.build(top + 1, edges, m, directed);
+    } catch (...) {
+        delete[] edges;
+        throw;
+    }
+    delete[] edges;
+    return m;
+}
+
+// 映射边表文件并解析建图，无法打开返回 -1
+long long loadEdgeList(const char* path, CSRGraph& g, bool directed = false, int threads = 0) {
+    MappedFile file;
+    if (!file.open(path)) return -1;
+    return parseEdgeList(file.data(), file.size(), g, directed, threads);
+}
+
+// 把边表写成文本（每行 "u v w"），无法创建文件或写入失败时返回 false
+bool saveEdgeList(const char* path, const Edge* edges, long long m) {
+    BufferedWriter out(4 << 20);
+    if (!out.open(path)) return false;
+    char buf[48];
+    for (long long i = 0; i < m; i++) {
+        int len = snprintf(buf, sizeof(buf), "%d %d %d\n", edges[i].u, edges[i].v, edges[i].w);
+        out.write(buf, len);
+    }
+    return out.close();
+}
+
+// 广度优先遍历：order 依次为访问到的顶点（order 本身兼作队列），O(V + E)
+void bfsOrder(const CSRGraph& g, int s, Vector<int>& order) {
+    int n = g.vertexCount();
+    Vector<bool> visited;
+    visited.resize(n);
+    bool* vis = visited.data();
+    order.resize(n);
+    int* q = order.data();
+    int head = 0, tail = 0;
+    q[tail++] = s;
+    vis[s] = true;
+    while (head < tail) {
+        int u = q[head++];
+        for (long long e = g.begin(u); e < g.end(u); e++) {
+            int v = g.target(e);
+            if (!vis[v]) {
+                vis[v] = true;
+                q[tail++] = v;
             }
         }
     }
+    order.resize(tail);
+}
+
+// 并行 BFS 的统计信息
+struct BFSStats {
+    long long visited;  // 访问到的顶点数
+    long long edges;    // 访问到的连通分量中的边数（无向边计一次），即 TEPS 的分子
+    int levels;         // 层数
+    int topDownSteps;   // 自顶向下的层数
+    int bottomUpSteps;  // 自底向上的层数
+    double seconds;
+
+    double teps() const { return seconds > 0 ? edges / seconds : 0; }
+};
+
+// 方向优化的并行 BFS（Beamer 等人的做法），按层同步：
+//   自顶向下：前沿顶点分块交给线程池，扫描出边，用 CAS 抢占未访问顶点的 parent，
+//             各线程把新顶点写入自己的缓冲区，再拼成下一层的前沿队列；
+//   自底向上：前沿存成位图，每个未访问顶点扫描自己的邻居，找到一个在前沿中的就停，
+//             线程按 64 位字对齐切分顶点，写下一层位图时互不冲突，不需要原子操作。
+// 前沿出边数 mf 超过未访问顶点边数 mu / ALPHA 时切到自底向上，前沿顶点数少于 V / BETA 时切回。
+// 有向图的自底向上需要入边，这里只对无向图启用。depth / parent 中 -1 表示不可达，起点的 parent 为自身
+const int BFS_ALPHA = 14;
+const int BFS_BETA = 24;
+
+BFSStats parallelBFS(const CSRGraph& g, int s, Vector<int>& depth, Vector<int>& parent, int threads = 0) {
+    auto t0 = chrono::steady_clock::now();
+    int n = g.vertexCount();
+    depth.resize(n);
+    parent.resize(n);
+    int* dep = depth.data();
+    atomic<int>* par = new atomic<int>[n];
+    for (int v = 0; v < n; v++) {
+        par[v].store(-1, memory_order_relaxed);
+        dep[v] = -1;
+    }
 
-public:
-    // 修复：Vector初始化改为逐个添加
-    Graph(Vector<string>& vtxList) {
-        vertexNum = vtxList.size();
-        for (int i = 0; i < vertexNum; i++) {
-            vtxMap[vtxList[i]] = i;
-            vertexs.push_back(vtxList[i]);
+    ThreadPool pool(threads);
+    int workers = pool.size();
+    Vector<int>* local = new Vector<int>[workers]; // 各线程新发现的顶点
+    long long* localEdges = new long long[workers];  // 各线程新顶点的度数和
+    int* queue = new int[n > 0 ? n : 1];
+    long long qSize = 0;
+    Bitmap bits[2] = {Bitmap(n), Bitmap(n)};
+    Bitmap* front = &bits[0]; // 当前前沿（自底向上时使用）
+    Bitmap* next = &bits[1];
+    const long long CHUNK = 1024;      // 自顶向下每个任务处理的前沿顶点数
+    const long long WORD_CHUNK = 64;   // 自底向上每个任务处理的位图字数
+
+    par[s].store(s, memory_order_relaxed);
+    dep[s] = 0;
+    queue[qSize++] = s;
+    BFSStats st = {1, 0, 0, 0, 0, 0};
+    long long degreeSum = g.degree(s);            // 已访问顶点的度数和
+    long long mf = g.degree(s);                    // 前沿出边数
+    long long mu = g.arcCount() - g.degree(s);     // 未访问顶点的边数
+    long long nf = 1;                               // 前沿顶点数
+    bool bottomUp = false;
+
+    for (int level = 0; nf > 0; level++) {
+        // 按前沿规模决定方向，需要时在队列和位图两种前沿表示之间转换
+        bool wantBottomUp = !g.directed() && (bottomUp ? nf >= n / BFS_BETA : mf > mu / BFS_ALPHA);
+        if (wantBottomUp && !bottomUp) {
+            front->reset();
+            for (long long i = 0; i < qSize; i++) front->set(queue[i]);
+        } else if (!wantBottomUp && bottomUp) {
+            qSize = 0;
+            for (long long k = front->findFirst(); k >= 0; k = front->findNext(k + 1)) queue[qSize++] = (int)k;
         }
-        // 初始化邻接矩阵
-        for (int i = 0; i < vertexNum; i++) {
-            Vector<int> row;
-            for (int j = 0; j < vertexNum; j++) {
-                if (i == j) row.push_back(0);
-                else row.push_back(INT_MAX);
+        bottomUp = wantBottomUp;
+        for (int w = 0; w < workers; w++) {
+            local[w].resize(0);
+            localEdges[w] = 0;
+        }
+
+        if (!bottomUp) {
+            st.topDownSteps++;
+            int tasks = (int)((qSize + CHUNK - 1) / CHUNK);
+            pool.run(tasks, [&](int t, int w) {
+                long long lo = t * CHUNK, hi = min(qSize, lo + CHUNK);
+                for (long long i = lo; i < hi; i++) {
+                    int u = queue[i];
+                    for (long long e = g.begin(u); e < g.end(u); e++) {
+                        int v = g.target(e);
+                        int expect = -1;
+                        if (par[v].load(memory_order_relaxed) == -1 &&
+                            par[v].compare_exchange_strong(expect, u, memory_order_relaxed)) {
+                            dep[v] = level + 1;
+                            local[w].push_back(v);
+                            localEdges[w] += g.degree(v);
+                        }
+                    }
+                }
+            });
+            qSize = 0;
+            for (int w = 0; w < workers; w++) {
+                memcpy(queue + qSize, local[w].data(), sizeof(int) * local[w].size());
+                qSize += local[w].size();
             }
-            adj.push_back(row);
+            nf = qSize;
+        } else {
+            st.bottomUpSteps++;
+            next->reset();
+            long long words = front->wordCount();
+            int tasks = (int)((words + WORD_CHUNK - 1) / WORD_CHUNK);
+            uint64_t* nextWords = next->words();
+            pool.run(tasks, [&](int t, int w) {
+                long long vLo = t * WORD_CHUNK * 64, vHi = min((long long)n, vLo + WORD_CHUNK * 64);
+                long long found = 0;
+                for (long long v = vLo; v < vHi; v++) {
+                    if (par[v].load(memory_order_relaxed) != -1) continue;
+                    for (long long e = g.begin((int)v); e < g.end((int)v); e++) {
+                        int u = g.target(e);
+                        if (front->test(u)) {
+                            par[v].store(u, memory_order_relaxed);
+                            dep[v] = level + 1;
+                            nextWords[v >> 6] |= 1ULL << (v & 63);
+                            localEdges[w] += g.degree((int)v);
+                            found++;
+                            break;
+                        }
+                    }
+                }
+                local[w].push_back((int)found); // 只记个数，自底向上不需要队列
+            });
+            nf = 0;
+            for (int w = 0; w < workers; w++) {
+                for (int i = 0; i < local[w].size(); i++) nf += local[w][i];
+            }
+            // 下一层直接写在底层字上，之后只经由 test / findNext 读取，不依赖 size()
+            Bitmap* tmp = front;
+            front = next;
+            next = tmp;
         }
+
+        mf = 0;
+        for (int w = 0; w < workers; w++) mf += localEdges[w];
+        mu -= mf;
+        degreeSum += mf;
+        st.visited += nf;
+        if (nf > 0) st.levels = level + 1;
     }
 
-    void addEdge(string uName, string vName, int weight) {
-        int u = vtxMap[uName];
-        int v = vtxMap[vName];
-        adj[u].replace(v, weight);
-        adj[v].replace(u, weight);
+    for (int v = 0; v < n; v++) parent[v] = par[v].load(memory_order_relaxed);
+    st.edges = g.directed() ? degreeSum : degreeSum / 2;
+    st.seconds = chrono::duration<double>(chrono::steady_clock::now() - t0).count();
+    delete[] queue;
+    delete[] localEdges;
+    delete[] local;
+    delete[] par;
+    return st;
+}
+
+// 深度优先遍历（显式栈 + 每个顶点一个边游标，不递归），访问顺序与递归版本相同，O(V + E)。
+// 栈深度可达 V，链状图上也不会爆调用栈
+void dfsOrder(const CSRGraph& g, int s, Vector<int>& order) {
+    int n = g.vertexCount();
+    Vector<bool> visited;
+    visited.resize(n);
+    bool* vis = visited.data();
+    Vector<int> cursor; // cursor[u]：u 的下一条待检查出边相对 begin(u) 的偏移
+    cursor.resize(n);
+    int* pos = cursor.data();
+    ArrayStack<int> stack;
+    order.resize(0);
+    vis[s] = true;
+    order.push_back(s);
+    stack.push(s);
+    while (!stack.empty()) {
+        int u = stack.peek(0);
+        if (pos[u] == g.degree(u)) {
+            stack.pop();
+            continue;
+        }
+        int v = g.target(g.begin(u) + pos[u]++);
+        if (!vis[v]) {
+            vis[v] = true;
+            order.push_back(v);
+            stack.push(v);
+        }
     }
+}
 
-    void printAdjMatrix() {
-        cout << "\n=== 图的邻接矩阵 ===" << endl;
-        cout << "   ";
-        for (int i = 0; i < vertexNum; i++) {
-            cout << vertexs[i] << "  ";
+// Dijkstra（线性扫描选最小），松弛只扫描 u 的出边：O(V^2 + E)。dist 中 INT_MAX 表示不可达
+void dijkstraScan(const CSRGraph& g, int s, Vector<int>& dist) {
+    int n = g.vertexCount();
+    Vector<bool> visited;
+    visited.resize(n);
+    dist.resize(n);
+    for (int i = 0; i < n; i++) dist[i] = INT_MAX;
+    dist[s] = 0;
+    for (int i = 0; i < n; i++) {
+        int minDist = INT_MAX, u = -1;
+        for (int v = 0; v < n; v++) {
+            if (!visited[v] && dist[v] < minDist) {
+                minDist = dist[v];
+                u = v;
+            }
         }
-        cout << endl;
-        for (int i = 0; i < vertexNum; i++) {
-            cout << vertexs[i] << "  ";
-            for (int j = 0; j < vertexNum; j++) {
-                if (adj[i][j] == INT_MAX) cout << "∞  ";
-                else cout << adj[i][j] << "  ";
+        if (u == -1) break;
+        visited[u] = true;
+        for (long long e = g.begin(u); e < g.end(u); e++) {
+            int v = g.target(e);
+            if (!visited[v] && dist[u] + g.weight(e) < dist[v]) dist[v] = dist[u] + g.weight(e);
+        }
+    }
+}
+
+// 不可达顶点的距离
+const long long INF_DIST = LLONG_MAX;
+
+// 堆优化 Dijkstra（边权非负）：4 叉索引堆 + decreaseKey，O((V + E) log V)。
+// 距离用 64 位累加，不会溢出；pred[v] 为最短路径上 v 的前驱（起点和不可达顶点为 -1）
+void dijkstra(const CSRGraph& g, int s, Vector<long long>& dist, Vector<int>& pred) {
+    int n = g.vertexCount();
+    dist.resize(n);
+    pred.resize(n);
+    long long* d = dist.data();
+    int* p = pred.data();
+    for (int i = 0; i < n; i++) {
+        d[i] = INF_DIST;
+        p[i] = -1;
+    }
+    IndexedHeap<long long> heap(n);
+    d[s] = 0;
+    heap.push(s, 0);
+    while (!heap.empty()) {
+        int u = heap.pop();
+        for (long long e = g.begin(u); e < g.end(u); e++) {
+            int v = g.target(e);
+            long long nd = d[u] + g.weight(e);
+            if (nd < d[v]) {
+                d[v] = nd;
+                p[v] = u;
+                heap.pushOrDecrease(v, nd);
             }
-            cout << endl;
         }
     }
+}
 
-    void BFS(string startName) {
-        int start = vtxMap[startName];
-        // 修复：Vector<bool>初始化改为逐个赋值
-        Vector<bool> visited;
-        for (int i = 0; i < vertexNum; i++) visited.push_back(false);
-        Queue<int> q;
-        cout << "\n=== BFS 遍历（起点：" << startName << "）===" << endl;
-        q.enqueue(start);
-        visited.replace(start, true);
-        while (!q.empty()) {
-            int u = q.front();
-            q.dequeue();
-            cout << vertexs[u] << " ";
-            for (int v = 0; v < vertexNum; v++) {
-                if (adj[u][v] != INT_MAX && !visited[v]) {
-                    visited.replace(v, true);
-                    q.enqueue(v);
+// 原子地把 a 改为 min(a, v)，返回是否改小了
+inline bool atomicMin(atomic<long long>& a, long long v) {
+    long long cur = a.load(memory_order_relaxed);
+    while (v < cur) {
+        if (a.compare_exchange_weak(cur, v, memory_order_relaxed)) return true;
+    }
+    return false;
+}
+
+// delta-stepping 的桶环长度上限：delta 不小于 maxWeight / DELTA_MAX_BUCKETS，环形数组不超过约 6.5 万个桶
+const long long DELTA_MAX_BUCKETS = 1 << 16;
+
+// 并行 delta-stepping 单源最短路（边权非负）。距离按 delta 分桶，从小到大处理：
+//   1. 取出当前桶的顶点（同一阶段去重、过滤已移到更小桶的过期项），并行松弛其轻边（w <= delta），
+//      被改小且仍落在当前桶的顶点进入下一阶段，直到当前桶不再有新顶点；
+//   2. 对本桶处理过的全部顶点并行松弛一次重边（w > delta，它们只会落到后面的桶）。
+// 距离用 CAS 取最小，各线程把被改小的顶点记在自己的缓冲区里，再串行放入对应的桶。
+// 任何一次松弛的目标桶都不超过当前桶 + maxWeight / delta，所以桶用长度为 maxWeight / delta + 2 的环形数组；
+// 非空桶的编号另放在一个以环位置为下标的索引堆里，处理完一个桶直接跳到下一个非空桶，不逐个经过空桶。
+// delta <= 0 时取 maxWeight / 平均度数（Meyer–Sanders 对随机权重的建议）；
+// 过小的 delta 会被调大到 maxWeight / DELTA_MAX_BUCKETS。返回实际使用的 delta
+long long deltaStepping(const CSRGraph& g, int s, Vector<long long>& dist, long long delta = 0, int threads = 0) {
+    int n = g.vertexCount();
+    long long m = g.arcCount();
+    long long maxWeight = 0;
+    for (long long e = 0; e < m; e++) {
+        if (g.weight(e) < 0) throw runtime_error("delta-stepping requires non-negative weights");
+        maxWeight = max(maxWeight, (long long)g.weight(e));
+    }
+    if (delta <= 0) delta = max(1LL, maxWeight / max(1LL, n > 0 ? m / n : 1));
+    delta = max(delta, (maxWeight + DELTA_MAX_BUCKETS - 1) / DELTA_MAX_BUCKETS);
+    const long long ring = maxWeight / delta + 2;
+
+    int* adj = nullptr;
+    int* wt = nullptr;
+    long long* split = nullptr;
+    atomic<long long>* d = nullptr;
+    int* phaseMark = nullptr;
+    long long* bucketMark = nullptr;
+    Vector<int>* buckets = nullptr;
+    Vector<int>* requests = nullptr;
+    auto release = [&]() {
+        delete[] requests;
+        delete[] buckets;
+        delete[] bucketMark;
+        delete[] phaseMark;
+        delete[] d;
+        delete[] split;
+        delete[] wt;
+        delete[] adj;
+    };
+    try {
+        // 每个顶点的出边重排为“轻边在前、重边在后”，split[u] 为第一条重边的位置
+        adj = new int[m > 0 ? m : 1];
+        wt = new int[m > 0 ? m : 1];
+        split = new long long[n > 0 ? n : 1];
+        parallelFor(n, threads, [&](int, long long lo, long long hi) {
+            for (long long u = lo; u < hi; u++) {
+                long long k = g.begin((int)u);
+                for (int heavy = 0; heavy < 2; heavy++) {
+                    if (heavy) split[u] = k;
+                    for (long long e = g.begin((int)u); e < g.end((int)u); e++) {
+                        if ((g.weight(e) > delta) == (bool)heavy) {
+                            adj[k] = g.target(e);
+                            wt[k] = g.weight(e);
+                            k++;
+                        }
+                    }
+                }
+            }
+        });
+
+        d = new atomic<long long>[n > 0 ? n : 1];
+        for (int v = 0; v < n; v++) d[v].store(INF_DIST, memory_order_relaxed);
+        phaseMark = new int[n > 0 ? n : 1];  // 同一阶段内去重
+        bucketMark = new long long[n > 0 ? n : 1]; // 同一桶内只记入一次
+        for (int v = 0; v < n; v++) phaseMark[v] = bucketMark[v] = -1;
+
+        buckets = new Vector<int>[ring];
+        IndexedHeap<long long> nonEmpty((int)ring); // 环位置 -> 桶编号，只含当前桶以外的非空桶
+        ThreadPool pool(threads);
+        int workers = pool.size();
+        requests = new Vector<int>[workers]; // 各线程被改小的顶点
+        Vector<int> frontier, settled;
+        const int CHUNK = 256;
+        long long cur = 0;
+
+        // 把顶点 v 放进其距离所在的桶
+        auto enqueue = [&](int v) {
+            long long b = d[v].load(memory_order_relaxed) / delta;
+            int slot = (int)(b % ring);
+            if (b != cur && buckets[slot].size() == 0) nonEmpty.push(slot, b);
+            buckets[slot].push_back(v);
+        };
+
+        // 并行松弛 list 中各顶点的轻边或重边，再把被改小的顶点放进桶
+        auto relax = [&](const Vector<int>& list, bool heavy) {
+            for (int w = 0; w < workers; w++) requests[w].resize(0);
+            int tasks = (list.size() + CHUNK - 1) / CHUNK;
+            const int* items = list.data();
+            pool.run(tasks, [&](int t, int w) {
+                int lo = t * CHUNK, hi = min(list.size(), lo + CHUNK);
+                for (int i = lo; i < hi; i++) {
+                    int u = items[i];
+                    long long du = d[u].load(memory_order_relaxed);
+                    long long eLo = heavy ? split[u] : g.begin(u), eHi = heavy ? g.end(u) : split[u];
+                    for (long long e = eLo; e < eHi; e++) {
+                        if (atomicMin(d[adj[e]], du + wt[e])) requests[w].push_back(adj[e]);
+                    }
+                }
+            });
+            for (int w = 0; w < workers; w++) {
+                for (int i = 0; i < requests[w].size(); i++) enqueue(requests[w][i]);
+            }
+        };
+
+        d[s].store(0, memory_order_relaxed);
+        cur = -1;
+        enqueue(s);
+        int phase = 0;
+        while (!nonEmpty.empty()) {
+            cur = nonEmpty.topKey();
+            Vector<int>& bucket = buckets[nonEmpty.pop()];
+            settled.resize(0);
+            while (bucket.size() > 0) {
+                frontier.resize(0);
+                for (int i = 0; i < bucket.size(); i++) {
+                    int v = bucket[i];
+                    if (d[v].load(memory_order_relaxed) / delta != cur || phaseMark[v] == phase) continue;
+                    phaseMark[v] = phase;
+                    frontier.push_back(v);
+                    if (bucketMark[v] != cur) {
+                        bucketMark[v] = cur;
+                        settled.push_back(v);
+                    }
                 }
+                bucket.resize(0);
+                phase++;
+                relax(frontier, false); // 轻边：结果可能回到当前桶
             }
+            relax(settled, true); // 重边：结果只落在后面的桶
         }
-        cout << endl;
+
+        dist.resize(n);
+        for (int v = 0; v < n; v++) dist[v] = d[v].load(memory_order_relaxed);
+    } catch (...) {
+        release();
+        throw;
     }
+    release();
+    return delta;
+}
 
-    void DFS(string startName) {
-        int start = vtxMap[startName];
-        Vector<bool> visited;
-        for (int i = 0; i < vertexNum; i++) visited.push_back(false);
-        cout << "\n=== DFS 遍历（起点：" << startName << "）===" << endl;
-        dfsHelper(start, visited);
-        cout << endl;
+// 由前驱数组还原 s 到 t 的路径（含两端），不可达时 path 为空
+void buildPath(const Vector<int>& pred, int s, int t, Vector<int>& path) {
+    path.resize(0);
+    if (t != s && pred[t] == -1) return;
+    for (int v = t; v != -1; v = v == s ? -1 : pred[v]) path.push_back(v);
+    for (int i = 0, j = path.size() - 1; i < j; i++, j--) {
+        int tmp = path[i];
+        path[i] = path[j];
+        path[j] = tmp;
     }
+}
 
-    void dijkstra(string startName) {
-        int start = vtxMap[startName];
-        Vector<int> dist;
-        Vector<bool> visited;
-        for (int i = 0; i < vertexNum; i++) {
-            dist.push_back(INT_MAX);
-            visited.push_back(false);
+// Prim（线性扫描选最小），O(V^2 + E)。parent[v] 为树上父节点（-1 表示根或不可达），
+// key[v] 为连接 v 的树边权重；返回最小生成树总权重
+long long primScan(const CSRGraph& g, int s, Vector<int>& parent, Vector<int>& key) {
+    int n = g.vertexCount();
+    Vector<bool> inMST;
+    inMST.resize(n);
+    parent.resize(n);
+    key.resize(n);
+    for (int i = 0; i < n; i++) {
+        parent[i] = -1;
+        key[i] = INT_MAX;
+    }
+    key[s] = 0;
+    long long totalWeight = 0;
+    for (int i = 0; i < n; i++) {
+        int minKey = INT_MAX, u = -1;
+        for (int v = 0; v < n; v++) {
+            if (!inMST[v] && key[v] < minKey) {
+                minKey = key[v];
+                u = v;
+            }
+        }
+        if (u == -1) break;
+        inMST[u] = true;
+        totalWeight += key[u];
+        for (long long e = g.begin(u); e < g.end(u); e++) {
+            int v = g.target(e);
+            if (!inMST[v] && g.weight(e) < key[v]) {
+                key[v] = g.weight(e);
+                parent[v] = u;
+            }
         }
-        dist.replace(start, 0);
+    }
+    return totalWeight;
+}
 
-        for (int i = 0; i < vertexNum - 1; i++) {
-            int minDist = INT_MAX, u = -1;
-            for (int v = 0; v < vertexNum; v++) {
-                if (!visited[v] && dist[v] < minDist) {
-                    minDist = dist[v];
-                    u = v;
+// 堆优化 Prim，求最小生成森林：先从 s 出发长出一棵树，再从每个尚未覆盖的顶点出发继续，
+// O((V + E) log V)。parent[v] 为森林中的父节点（各树的根为 -1），key[v] 为连接 v 的树边权重；
+// 返回森林总权重
+long long primForest(const CSRGraph& g, int s, Vector<int>& parent, Vector<int>& key) {
+    int n = g.vertexCount();
+    parent.resize(n);
+    key.resize(n);
+    int* par = parent.data();
+    int* k = key.data();
+    Vector<bool> inTree;
+    inTree.resize(n);
+    bool* done = inTree.data();
+    for (int i = 0; i < n; i++) {
+        par[i] = -1;
+        k[i] = INT_MAX;
+    }
+    IndexedHeap<int> heap(n);
+    long long totalWeight = 0;
+    for (int r = 0; r < n; r++) {
+        int root = r == 0 ? s : r - (r <= s); // 先处理 s，其余顶点按编号依次作为新树的根
+        if (done[root]) continue;
+        k[root] = 0;
+        heap.push(root, 0);
+        while (!heap.empty()) {
+            int u = heap.pop();
+            done[u] = true;
+            totalWeight += k[u];
+            for (long long e = g.begin(u); e < g.end(u); e++) {
+                int v = g.target(e);
+                if (!done[v] && g.weight(e) < k[v]) {
+                    k[v] = g.weight(e);
+                    par[v] = u;
+                    heap.pushOrDecrease(v, g.weight(e));
                 }
             }
-            if (u == -1) break;
-            visited.replace(u, true);
-            for (int v = 0; v < vertexNum; v++) {
-                if (!visited[v] && adj[u][v] != INT_MAX && dist[u] != INT_MAX) {
-                    if (dist[u] + adj[u][v] < dist[v]) {
-                        dist.replace(v, dist[u] + adj[u][v]);
+        }
+    }
+    return totalWeight;
+}
+
+// 按权重对边做稳定的 LSD 基数排序（两趟 16 位，O(E)）；权重的符号位取反后按无符号比较
+void sortEdgesByWeight(Edge* edges, long long m) {
+    Edge* tmp = new Edge[m > 0 ? m : 1];
+    long long* count = new long long[65537];
+    Edge* src = edges;
+    Edge* dst = tmp;
+    for (int shift = 0; shift < 32; shift += 16) {
+        memset(count, 0, sizeof(long long) * 65537);
+        for (long long i = 0; i < m; i++) count[((((uint32_t)src[i].w) ^ 0x80000000u) >> shift & 0xFFFF) + 1]++;
+        if (count[1 + ((((uint32_t)(m ? src[0].w : 0)) ^ 0x80000000u) >> shift & 0xFFFF)] == m) continue; // 本趟各边数字相同
+        for (int d = 0; d < 65536; d++) count[d + 1] += count[d];
+        for (long long i = 0; i < m; i++) dst[count[(((uint32_t)src[i].w) ^ 0x80000000u) >> shift & 0xFFFF]++] = src[i];
+        Edge* t = src;
+        src = dst;
+        dst = t;
+    }
+    if (src != edges) memcpy(edges, src, sizeof(Edge) * m);
+    delete[] count;
+    delete[] tmp;
+}
+
+// Kruskal 求最小生成森林：边按权重基数排序后依次用并查集判环，O(E α(V))（不计排序）。
+// 森林的边写入 forest，返回总权重
+long long kruskal(int n, const Edge* edges, long long m, Vector<Edge>& forest) {
+    Edge* sorted = new Edge[m > 0 ? m : 1];
+    memcpy(sorted, edges, sizeof(Edge) * m);
+    sortEdgesByWeight(sorted, m);
+    UnionFind uf(n);
+    forest.resize(0);
+    long long totalWeight = 0;
+    for (long long i = 0; i < m && forest.size() < n - 1; i++) {
+        if (uf.unite(sorted[i].u, sorted[i].v)) {
+            forest.push_back(sorted[i]);
+            totalWeight += sorted[i].w;
+        }
+    }
+    delete[] sorted;
+    return totalWeight;
+}
+
+// 并行 Borůvka 求最小生成森林。每轮：
+//   1. 各线程分段扫描剩余的边，用原子 CAS 为每个连通分量记录最轻的出边
+//      （键 = 权重 << 32 | 边号，权重相同时按边号，保证全序、不会选出环）；
+//   2. 串行用并查集合并所有被选中的边，再把每个顶点的分量号压平；
+//   3. 并行删掉两端已在同一分量的边。
+// 每轮分量数至少减半，共 O(log V) 轮，每轮 O(E / 线程数 + V)。要求边数小于 2^32
+long long boruvka(int n, const Edge* edges, long long m, Vector<Edge>& forest, int threads = 0) {
+    threads = resolveThreads(threads);
+    forest.resize(0);
+    long long totalWeight = 0;
+    if (n == 0) return 0;
+    UnionFind uf(n);
+    int* comp = new int[n];
+    for (int v = 0; v < n; v++) comp[v] = v;
+    atomic<uint64_t>* best = new atomic<uint64_t>[n];
+    uint32_t* live = new uint32_t[m > 0 ? m : 1]; // 仍可能连接两个不同分量的边号
+    uint32_t* next = new uint32_t[m > 0 ? m : 1];
+    long long liveCount = 0;
+    for (long long i = 0; i < m; i++) {
+        if (edges[i].u != edges[i].v) live[liveCount++] = (uint32_t)i;
+    }
+    long long* kept = new long long[threads + 1];
+    const uint64_t NONE = ~0ULL;
+
+    while (liveCount > 0) {
+        for (int v = 0; v < n; v++) best[v].store(NONE, memory_order_relaxed);
+        parallelFor(liveCount, threads, [&](int, long long lo, long long hi) {
+            for (long long k = lo; k < hi; k++) {
+                uint32_t i = live[k];
+                const Edge& e = edges[i];
+                uint64_t key = (uint64_t)(((uint32_t)e.w) ^ 0x80000000u) << 32 | i;
+                int c[2] = {comp[e.u], comp[e.v]};
+                for (int t = 0; t < 2; t++) {
+                    uint64_t cur = best[c[t]].load(memory_order_relaxed);
+                    while (key < cur && !best[c[t]].compare_exchange_weak(cur, key, memory_order_relaxed)) {
                     }
                 }
             }
+        });
+
+        int merged = 0;
+        for (int c = 0; c < n; c++) {
+            uint64_t key = best[c].load(memory_order_relaxed);
+            if (key == NONE) continue;
+            const Edge& e = edges[(uint32_t)key];
+            if (uf.unite(e.u, e.v)) { // 两个分量可能选中同一条边，只计一次
+                forest.push_back(e);
+                totalWeight += e.w;
+                merged++;
+            }
         }
+        if (merged == 0) break;
+        for (int v = 0; v < n; v++) comp[v] = uf.find(v);
 
-        cout << "\n=== Dijkstra 单源最短路径（起点：" << startName << "）===" << endl;
+        // 并行压缩边表：先统计每段保留的边数，前缀和后各自写入
+        int parts = (int)min<long long>(threads, liveCount);
+        parallelFor(liveCount, parts, [&](int t, long long lo, long long hi) {
+            long long c = 0;
+            for (long long k = lo; k < hi; k++) c += comp[edges[live[k]].u] != comp[edges[live[k]].v];
+            kept[t + 1] = c;
+        });
+        kept[0] = 0;
+        for (int t = 0; t < parts; t++) kept[t + 1] += kept[t];
+        parallelFor(liveCount, parts, [&](int t, long long lo, long long hi) {
+            long long pos = kept[t];
+            for (long long k = lo; k < hi; k++) {
+                if (comp[edges[live[k]].u] != comp[edges[live[k]].v]) next[pos++] = live[k];
+            }
+        });
+        liveCount = kept[parts];
+        uint32_t* t = live;
+        live = next;
+        next = t;
+    }
+
+    delete[] kept;
+    delete[] next;
+    delete[] live;
+    delete[] best;
+    delete[] comp;
+    return totalWeight;
+}
+
+// 无向图的 lowpoint 深度优先框架（显式栈 + 边游标，不递归），O(V + E)：
+//   onTree(u, v, w)    沿树边 u -> v 第一次进入 v
+//   onBack(u, v, w)    返祖边 u -> v（dfn[v] < dfn[u]，每条只报告一次）
+//   onRetreat(p, u, w) 从 v = u 回退到父节点 p；此时 low[u] 已确定，回调可读取 dfn / low
+//   onRoot(r, children) 以 r 为根的树遍历结束，children 为 r 的树儿子个数
+// 到父节点的边只跳过一条，因此重边会被当作返祖边（两点间的重边不是桥）
+template <typename OnTree, typename OnBack, typename OnRetreat, typename OnRoot>
+void lowpointDFS(const CSRGraph& g, Vector<int>& dfn, Vector<int>& low,
+                 OnTree onTree, OnBack onBack, OnRetreat onRetreat, OnRoot onRoot) {
+    int n = g.vertexCount();
+    dfn.resize(n);
+    low.resize(n);
+    Vector<int> parent, cursor, parentWeight;
+    Vector<bool> skipped; // 是否已跳过回到父节点的那条树边
+    parent.resize(n);
+    cursor.resize(n);
+    parentWeight.resize(n);
+    skipped.resize(n);
+    int *d = dfn.data(), *l = low.data(), *par = parent.data(), *pos = cursor.data(), *pw = parentWeight.data();
+    bool* skip = skipped.data();
+    ArrayStack<int> stack;
+    int time = 0;
+    for (int r = 0; r < n; r++) {
+        if (d[r]) continue;
+        int children = 0;
+        d[r] = l[r] = ++time;
+        par[r] = -1;
+        stack.push(r);
+        while (!stack.empty()) {
+            int u = stack.peek(0);
+            if (pos[u] < g.degree(u)) {
+                long long e = g.begin(u) + pos[u]++;
+                int v = g.target(e), w = g.weight(e);
+                if (v == par[u] && !skip[u]) {
+                    skip[u] = true;
+                } else if (d[v] == 0) {
+                    par[v] = u;
+                    pw[v] = w;
+                    d[v] = l[v] = ++time;
+                    if (u == r) children++;
+                    onTree(u, v, w);
+                    stack.push(v);
+                } else if (d[v] < d[u]) {
+                    if (d[v] < l[u]) l[u] = d[v];
+                    onBack(u, v, w);
+                }
+                continue;
+            }
+            stack.pop();
+            int p = par[u];
+            if (p != -1) {
+                if (l[u] < l[p]) l[p] = l[u];
+                onRetreat(p, u, pw[u]);
+            }
+        }
+        onRoot(r, children);
+    }
+}
+
+// 关节点与桥：非根顶点 p 有儿子 u 满足 low[u] >= dfn[p] 时 p 是关节点，根有两个以上儿子时是关节点；
+// 树边 (p, u) 满足 low[u] > dfn[p] 时是桥
+void cutVerticesAndBridges(const CSRGraph& g, Vector<bool>& isCut, Vector<Edge>& bridges) {
+    int n = g.vertexCount();
+    Vector<int> dfn, low;
+    isCut.resize(0);
+    isCut.resize(n);
+    bridges.resize(0);
+    bool* cut = isCut.data();
+    lowpointDFS(g, dfn, low,
+        [](int, int, int) {},
+        [](int, int, int) {},
+        [&](int p, int u, int w) {
+            const int *d = dfn.data(), *l = low.data();
+            if (l[u] >= d[p]) cut[p] = true; // 对根也会置位，树遍历结束时由 onRoot 按儿子数改正
+            if (l[u] > d[p]) bridges.push_back({p, u, w});
+        },
+        [&](int r, int children) { cut[r] = children > 1; });
+}
+
+void cutVertices(const CSRGraph& g, Vector<bool>& isCut) {
+    Vector<Edge> bridges;
+    cutVerticesAndBridges(g, isCut, bridges);
+}
+
+// 点双连通分量：边入栈，回退到 p 时若 low[u] >= dfn[p]，弹出直到树边 (p, u)，这些边构成一个分量。
+// 分量 k 的边为 bccEdges 中的 [bccStart[k], bccStart[k + 1])；孤立顶点不属于任何分量
+int biconnectedComponents(const CSRGraph& g, Vector<int>& bccStart, Vector<Edge>& bccEdges) {
+    Vector<int> dfn, low;
+    ArrayStack<Edge> edgeStack;
+    bccStart.resize(0);
+    bccEdges.resize(0);
+    lowpointDFS(g, dfn, low,
+        [&](int u, int v, int w) { edgeStack.push({u, v, w}); },
+        [&](int u, int v, int w) { edgeStack.push({u, v, w}); },
+        [&](int p, int u, int) {
+            if (low.data()[u] < dfn.data()[p]) return;
+            bccStart.push_back(bccEdges.size());
+            for (;;) {
+                Edge e = edgeStack.pop();
+                bccEdges.push_back(e);
+                if (e.u == p && e.v == u) break;
+            }
+        },
+        [](int, int) {});
+    int count = bccStart.size();
+    bccStart.push_back(bccEdges.size());
+    return count;
+}
+
+// 有向图强连通分量（Tarjan，显式栈 + 边游标），O(V + E)。
+// comp[v] 为 v 所在分量的编号（按逆拓扑序从 0 开始），返回分量个数
+int stronglyConnectedComponents(const CSRGraph& g, Vector<int>& comp) {
+    int n = g.vertexCount();
+    Vector<int> index, low, cursor;
+    Vector<bool> onStack;
+    index.resize(n);
+    low.resize(n);
+    cursor.resize(n);
+    onStack.resize(n);
+    comp.resize(n);
+    int *idx = index.data(), *l = low.data(), *pos = cursor.data(), *c = comp.data();
+    bool* on = onStack.data();
+    ArrayStack<int> call, scc; // call：模拟递归的调用栈；scc：Tarjan 的顶点栈
+    int time = 0, count = 0;
+    for (int r = 0; r < n; r++) {
+        if (idx[r]) continue;
+        idx[r] = l[r] = ++time;
+        call.push(r);
+        scc.push(r);
+        on[r] = true;
+        while (!call.empty()) {
+            int u = call.peek(0);
+            if (pos[u] < g.degree(u)) {
+                int v = g.target(g.begin(u) + pos[u]++);
+                if (idx[v] == 0) {
+                    idx[v] = l[v] = ++time;
+                    call.push(v);
+                    scc.push(v);
+                    on[v] = true;
+                } else if (on[v] && idx[v] < l[u]) {
+                    l[u] = idx[v];
+                }
+                continue;
+            }
+            call.pop();
+            if (!call.empty()) {
+                int p = call.peek(0);
+                if (l[u] < l[p]) l[p] = l[u];
+            }
+            if (l[u] == idx[u]) { // u 是分量的根：弹出栈中 u 以上的顶点
+                int v;
+                do {
+                    v = scc.pop();
+                    on[v] = false;
+                    c[v] = count;
+                } while (v != u);
+                count++;
+            }
+        }
+    }
+    return count;
+}
+
+// 带顶点名的无向图：addEdge 只把边追加到边表，第一次运行算法时再整体建成 CSR
+class Graph {
+private:
+    int vertexNum;
+    Vector<Edge> edges;
+    CSRGraph csr;
+    bool dirty; // 边表有变化，CSR 需要重建
+    StringInterner names; // 顶点名 <-> 稠密编号
+
+public:
+    Graph(Vector<string>& vtxList) : vertexNum(0), dirty(true) {
+        names.reserve(vtxList.size());
+        for (int i = 0; i < vtxList.size(); i++) addVertex(vtxList[i]);
+    }
+
+    // 加入新顶点并返回编号，重名时抛出异常
+    int addVertex(string_view name) {
+        if (names.contains(name)) throw runtime_error("Duplicate vertex: " + string(name));
+        int id = names.intern(name);
+        vertexNum = names.size();
+        dirty = true;
+        return id;
+    }
+
+    // 顶点名对应的编号，未知的名字抛出异常（不会被悄悄当成 0 号顶点）
+    int vertexId(string_view name) const {
+        int id = names.find(name);
+        if (id == StringInterner::NOT_FOUND) throw runtime_error("Unknown vertex: " + string(name));
+        return id;
+    }
+
+    void addEdge(string_view uName, string_view vName, int weight) {
+        int u = vertexId(uName);
+        int v = vertexId(vName);
+        edges.push_back({u, v, weight});
+        dirty = true;
+    }
+
+    // 当前边表对应的 CSR
+    const CSRGraph& sparse() {
+        if (dirty) {
+            csr.build(vertexNum, edges.data(), edges.size());
+            dirty = false;
+        }
+        return csr;
+    }
+
+    void printAdjMatrix() {
+        const CSRGraph& g = sparse();
+        cout << "\n=== 图的邻接矩阵 ===" << endl;
+        cout << "   ";
         for (int i = 0; i < vertexNum; i++) {
-            cout << startName << " -> " << vertexs[i] << "：";
-            if (dist[i] == INT_MAX) cout << "不可达";
-            else cout << dist[i];
+            cout << names.name(i) << "  ";
+        }
+        cout << endl;
+        // 只为正在打印的一行展开稠密数组（重边取最后加入的权重）
+        Vector<int> row;
+        row.resize(vertexNum);
+        for (int i = 0; i < vertexNum; i++) {
+            for (int j = 0; j < vertexNum; j++) row[j] = i == j ? 0 : INT_MAX;
+            for (long long e = g.begin(i); e < g.end(i); e++) row[g.target(e)] = g.weight(e);
+            cout << names.name(i) << "  ";
+            for (int j = 0; j < vertexNum; j++) {
+                if (row[j] == INT_MAX) cout << "∞  ";
+                else cout << row[j] << "  ";
+            }
             cout << endl;
         }
     }
 
-    void prim(string startName) {
-        int start = vtxMap[startName];
-        Vector<int> key;
-        Vector<bool> inMST;
-        Vector<int> parent;
+    void BFS(string_view startName) {
+        Vector<int> order;
+        bfsOrder(sparse(), vertexId(startName), order);
+        cout << "\n=== BFS 遍历（起点：" << startName << "）===" << endl;
+        for (int i = 0; i < order.size(); i++) cout << names.name(order[i]) << " ";
+        cout << endl;
+    }
+
+    void DFS(string_view startName) {
+        Vector<int> order;
+        dfsOrder(sparse(), vertexId(startName), order);
+        cout << "\n=== DFS 遍历（起点：" << startName << "）===" << endl;
+        for (int i = 0; i < order.size(); i++) cout << names.name(order[i]) << " ";
+        cout << endl;
+    }
+
+    void dijkstra(string_view startName) {
+        int start = vertexId(startName);
+        Vector<long long> dist;
+        Vector<int> pred, path;
+        ::dijkstra(sparse(), start, dist, pred);
+        cout << "\n=== Dijkstra 单源最短路径（起点：" << startName << "）===" << endl;
         for (int i = 0; i < vertexNum; i++) {
-            key.push_back(INT_MAX);
-            inMST.push_back(false);
-            parent.push_back(-1);
-        }
-        key.replace(start, 0);
-        int totalWeight = 0;
-
-        for (int i = 0; i < vertexNum - 1; i++) {
-            int minKey = INT_MAX, u = -1;
-            for (int v = 0; v < vertexNum; v++) {
-                if (!inMST[v] && key[v] < minKey) {
-                    minKey = key[v];
-                    u = v;
-                }
-            }
-            if (u == -1) break;
-            inMST.replace(u, true);
-            totalWeight += key[u];
-            for (int v = 0; v < vertexNum; v++) {
-                if (!inMST[v] && adj[u][v] != INT_MAX && adj[u][v] < key[v]) {
-                    key.replace(v, adj[u][v]);
-                    parent.replace(v, u);
-                }
+            cout << startName << " -> " << names.name(i) << "：";
+            if (dist[i] == INF_DIST) {
+                cout << "不可达" << endl;
+                continue;
             }
+            cout << dist[i] << "（路径：";
+            buildPath(pred, start, i, path);
+            for (int k = 0; k < path.size(); k++) cout << (k ? " -> " : "") << names.name(path[k]);
+            cout << "）" << endl;
         }
+    }
 
+    void prim(string_view startName) {
+        Vector<int> parent, key;
+        long long totalWeight = primForest(sparse(), vertexId(startName), parent, key);
         cout << "\n=== Prim 最小生成树（起点：" << startName << "）===" << endl;
         cout << "边（起点-终点）：权重" << endl;
         for (int i = 0; i < vertexNum; i++) {
             if (parent[i] != -1) {
-                cout << vertexs[parent[i]] << " - " << vertexs[i] << "：" << adj[parent[i]][i] << endl;
+                cout << names.name(parent[i]) << " - " << names.name(i) << "：" << key[i] << endl;
             }
         }
         cout << "最小生成树总权重：" << totalWeight << endl;
     }
 
-    void findCutVertices() {
-        Vector<int> dfn;
-        Vector<int> low;
-        Vector<bool> isCut;
-        for (int i = 0; i < vertexNum; i++) {
-            dfn.push_back(0);
-            low.push_back(0);
-            isCut.push_back(false);
+    void kruskal() {
+        Vector<Edge> forest;
+        long long totalWeight = ::kruskal(vertexNum, edges.data(), edges.size(), forest);
+        cout << "\n=== Kruskal 最小生成树 ===" << endl;
+        cout << "边（按加入顺序）：权重" << endl;
+        for (int i = 0; i < forest.size(); i++) {
+            cout << names.name(forest[i].u) << " - " << names.name(forest[i].v) << "：" << forest[i].w << endl;
         }
-        int time = 0;
+        cout << "最小生成树总权重：" << totalWeight << endl;
+    }
 
+    void findCutVertices() {
+        Vector<bool> isCut;
+        cutVertices(sparse(), isCut);
         cout << "\n=== Tarjan 算法找关节点 ===" << endl;
-        for (int i = 0; i < vertexNum; i++) {
-            if (dfn[i] == 0) {
-                tarjan(i, -1, dfn, low, isCut, time);
-            }
-        }
-
         cout << "图中的关节点：";
         bool hasCut = false;
         for (int i = 0; i < vertexNum; i++) {
             if (isCut[i]) {
-                cout << vertexs[i] << " ";
+                cout << names.name(i) << " ";
                 hasCut = true;
             }
         }
@@ -242,7 +1321,583 @@ public:
     }
 };
 
-int main() {
+// 随机稀疏图：n 个顶点、m 条边，权重在 [1, maxWeight] 上均匀分布（同一种子结果相同）
+void randomEdges(int n, long long m, int maxWeight, Vector<Edge>& edges, uint64_t seed = DEFAULT_SEED) {
+    edges.resize((int)m);
+    Edge* e = edges.data();
+    parallelGenerate(e, m, seed, 0, [n, maxWeight](Xoshiro256& rng) {
+        Edge x;
+        x.u = (int)rng.nextBelow(n);
+        x.v = (int)rng.nextBelow(n);
+        x.w = (int)rng.nextInt(1, maxWeight);
+        return x;
+    });
+}
+
+// 大规模稀疏图：建 CSR 并做一次 BFS，报告耗时与内存（同规模的邻接矩阵需要 4 * V^2 字节）
+void testLargeGraph(int n, long long m) {
+    Vector<Edge> edges;
+    randomEdges(n, m, 100, edges);
+    auto t0 = chrono::steady_clock::now();
+    CSRGraph g;
+    g.build(n, edges.data(), m);
+    auto t1 = chrono::steady_clock::now();
+    Vector<int> order;
+    bfsOrder(g, 0, order);
+    auto t2 = chrono::steady_clock::now();
+    Vector<long long> dist;
+    Vector<int> pred;
+    dijkstra(g, 0, dist, pred);
+    auto t3 = chrono::steady_clock::now();
+    Vector<int> depth, parent;
+    BFSStats bfs = parallelBFS(g, 0, depth, parent);
+    auto t8 = chrono::steady_clock::now();
+    Vector<long long> dist2;
+    long long delta = deltaStepping(g, 0, dist2);
+    auto t9 = chrono::steady_clock::now();
+    bool sameDist = true;
+    for (int v = 0; v < n; v++) sameDist = sameDist && dist2[v] == dist[v];
+    cout << "\n=== 稀疏图（" << n << " 个顶点，" << m << " 条边）===" << endl;
+    cout << "CSR 占用 " << g.memoryBytes() / 1e6 << " MB（邻接矩阵需 " << 4.0 * n * n / 1e9 << " GB）" << endl;
+    cout << "建图 " << chrono::duration<double>(t1 - t0).count() << " s，BFS 访问 " << order.size()
+         << " 个顶点，耗时 " << chrono::duration<double>(t2 - t1).count() << " s" << endl;
+    cout << "堆优化 Dijkstra 耗时 " << chrono::duration<double>(t3 - t2).count() << " s" << endl;
+    cout << "方向优化并行 BFS（" << hardwareThreads() << " 线程）：" << bfs.levels << " 层（自顶向下 "
+         << bfs.topDownSteps << "，自底向上 " << bfs.bottomUpSteps << "），" << bfs.seconds << " s，"
+         << bfs.teps() / 1e6 << " MTEPS" << endl;
+    cout << "并行 delta-stepping（delta = " << delta << "）耗时 " << chrono::duration<double>(t9 - t8).count()
+         << " s，" << (sameDist ? "与 Dijkstra 一致" : "与 Dijkstra 不一致！") << endl;
+
+    Vector<int> key;
+    Vector<Edge> forest;
+    auto t4 = chrono::steady_clock::now();
+    long long wPrim = primForest(g, 0, parent, key);
+    auto t5 = chrono::steady_clock::now();
+    long long wKruskal = kruskal(n, edges.data(), m, forest);
+    auto t6 = chrono::steady_clock::now();
+    long long wBoruvka = boruvka(n, edges.data(), m, forest);
+    auto t7 = chrono::steady_clock::now();
+    cout << "最小生成森林（" << n - forest.size() << " 棵树）总权重 " << wBoruvka
+         << (wPrim == wKruskal && wKruskal == wBoruvka ? "，三种算法一致" : "，结果不一致！") << endl;
+    cout << "Prim " << chrono::duration<double>(t5 - t4).count() << " s，Kruskal "
+         << chrono::duration<double>(t6 - t5).count() << " s，并行 Borůvka（" << hardwareThreads() << " 线程）"
+         << chrono::duration<double>(t7 - t6).count() << " s" << endl;
+}
+
+// 随机位图（长度跨越多个 64 位字、含尾部不足 4 字的部分）与 bool 数组逐位对照：
+// set / clear / count / findNext 枚举、AND / OR / XOR / ANDNOT（长度不同的两个位图，覆盖 AVX2 主循环与尾部），
+// 以及 rank1 / rank0 对每个位置、select1 对每个置位的结果
+bool testBitmap(int rounds = 60) {
+    Xoshiro256 rng(DEFAULT_SEED);
+    auto fill = [&](Bitmap& b, Vector<bool>& ref, long long n, int density) {
+        ref.resize((int)n);
+        for (long long i = 0; i < n; i++) {
+            ref[(int)i] = (long long)rng.nextBelow(100) < density;
+            if (ref[(int)i]) b.set(i);
+        }
+        for (int k = 0; k < n / 10; k++) { // 随机清除一部分，检查 size 的维护
+            long long i = (long long)rng.nextBelow(n);
+            ref[(int)i] = false;
+            b.clear(i);
+        }
+    };
+    auto same = [](const Bitmap& b, const Vector<bool>& ref) {
+        long long ones = 0, last = -1;
+        for (int i = 0; i < ref.size(); i++) {
+            if (b.test(i) != ref[i]) return false;
+            if (ref[i]) ones++, last = i;
+        }
+        if (b.count() != ones || b.size() != last + 1) return false;
+        long long k = b.findFirst();
+        for (int i = 0; i < ref.size(); i++) {
+            if (!ref[i]) continue;
+            if (k != i) return false;
+            k = b.findNext(k + 1);
+        }
+        return k == -1;
+    };
+
+    for (int r = 0; r < rounds; r++) {
+        long long n = rng.nextInt(1, 5000), n2 = rng.nextInt(1, 5000);
+        const int densities[] = {1, 50, 99};
+        Bitmap a(r % 3 ? 64 : n), b;
+        Vector<bool> ra, rb;
+        fill(a, ra, n, densities[r % 3]);
+        fill(b, rb, n2, densities[(r / 3) % 3]);
+        if (!same(a, ra) || !same(b, rb)) return false;
+
+        // rank / select
+        a.buildRankIndex();
+        long long ones = 0, expectOnes = 0;
+        for (int i = 0; i < ra.size(); i++) expectOnes += ra[i];
+        for (long long i = 0; i <= n + 130; i++) {
+            if (a.rank1(i) != ones || a.rank0(i) != i - ones) return false;
+            if (i < n && ra[(int)i]) {
+                if (a.select1(ones) != i) return false;
+                ones++;
+            }
+        }
+        if (a.select1(expectOnes) != -1 || a.select1(-1) != -1) return false;
+        a.set(0);
+        try {
+            a.rank1(1);
+            return false; // 修改后索引应失效
+        } catch (const runtime_error&) {
+        }
+        ra[0] = true;
+
+        // 批量运算：op = r % 4
+        long long len = max(n, n2);
+        Vector<bool> expect;
+        expect.resize((int)len);
+        for (long long i = 0; i < len; i++) {
+            bool x = i < n && ra[(int)i], y = i < n2 && rb[(int)i];
+            const bool results[] = {x && y, x || y, x != y, x && !y};
+            expect[(int)i] = results[r % 4];
+        }
+        if (r % 4 == 0) a.andWith(b);
+        else if (r % 4 == 1) a.orWith(b);
+        else if (r % 4 == 2) a.xorWith(b);
+        else a.andNotWith(b);
+        if (!same(a, expect)) return false;
+    }
+    return true;
+}
+
+// 校验并行 BFS：depth 与串行 BFS 的层数一致，每个 parent 都是上一层的邻居
+bool checkBFS(const CSRGraph& g, int s, const Vector<int>& depth, const Vector<int>& parent) {
+    int n = g.vertexCount();
+    Vector<int> order, expect;
+    bfsOrder(g, s, order);
+    expect.resize(n);
+    for (int v = 0; v < n; v++) expect[v] = -1;
+    expect[s] = 0;
+    for (int i = 0; i < order.size(); i++) {
+        int u = order[i];
+        for (long long e = g.begin(u); e < g.end(u); e++) {
+            if (expect[g.target(e)] == -1) expect[g.target(e)] = expect[u] + 1;
+        }
+    }
+    for (int v = 0; v < n; v++) {
+        if (depth[v] != expect[v]) return false;
+        if (v == s || depth[v] == -1) {
+            if (parent[v] != (v == s ? s : -1)) return false;
+            continue;
+        }
+        int p = parent[v];
+        if (p < 0 || depth[p] != depth[v] - 1) return false;
+        bool adjacent = false;
+        for (long long e = g.begin(p); e < g.end(p) && !adjacent; e++) adjacent = g.target(e) == v;
+        if (!adjacent) return false;
+    }
+    return true;
+}
+
+bool testParallelBFS(int rounds = 100) {
+    Xoshiro256 rng(DEFAULT_SEED);
+    for (int r = 0; r < rounds; r++) {
+        int n = (int)rng.nextInt(1, 5000);
+        long long m = rng.nextInt(0, 8 * n);
+        Vector<Edge> edges;
+        randomEdges(n, m, 1, edges, DEFAULT_SEED + r);
+        CSRGraph g;
+        g.build(n, edges.data(), m, r % 4 == 3);
+        int s = (int)rng.nextBelow(n);
+        Vector<int> depth, parent;
+        parallelBFS(g, s, depth, parent, 1 + r % 4);
+        if (!checkBFS(g, s, depth, parent)) return false;
+    }
+    return true;
+}
+
+// 随机图上对比 delta-stepping 与堆优化 Dijkstra（自动 / 很小 / 很大的 delta，权重最大到 1e9，1~4 个线程）
+bool testDeltaStepping(int rounds = 200) {
+    Xoshiro256 rng(DEFAULT_SEED);
+    for (int r = 0; r < rounds; r++) {
+        int n = (int)rng.nextInt(1, 2000);
+        long long m = rng.nextInt(0, 6 * n);
+        Vector<Edge> edges;
+        const int maxWeights[] = {3, 1000000000, 100000, 100000, 100000}; // 含远大于 delta 的权重
+        randomEdges(n, m, maxWeights[r % 5], edges, DEFAULT_SEED + r);
+        if (r % 7 == 0) {
+            for (int i = 0; i < edges.size(); i += 3) edges[i].w = 0; // 含零权边
+        }
+        CSRGraph g;
+        g.build(n, edges.data(), m, r % 2 == 1);
+        int s = (int)rng.nextBelow(n);
+        Vector<long long> expect, dist;
+        Vector<int> pred;
+        dijkstra(g, s, expect, pred);
+        const long long deltas[] = {0, 1, 1000000};
+        deltaStepping(g, s, dist, deltas[r % 3], 1 + r % 4);
+        for (int v = 0; v < n; v++) {
+            if (dist[v] != expect[v]) return false;
+        }
+    }
+    return true;
+}
+
+// 两个 CSR 是否完全相同（顶点数、弧序、权重）
+bool sameCSR(const CSRGraph& a, const CSRGraph& b) {
+    if (a.vertexCount() != b.vertexCount() || a.arcCount() != b.arcCount()) return false;
+    int n = a.vertexCount();
+    long long m = a.arcCount();
+    return memcmp(a.offsets(), b.offsets(), sizeof(long long) * ((size_t)n + 1)) == 0 &&
+           memcmp(a.neighbors(), b.neighbors(), sizeof(int) * m) == 0 &&
+           memcmp(a.weights(), b.weights(), sizeof(int) * m) == 0;
+}
+
+// 随机边表写成文本（混入注释、空行、制表符、\r\n 和省略的权重），并行解析后应与直接建图完全一致；
+// 再在随机位置插入一行坏数据，检查报告的行号
+bool testEdgeListParser(int rounds = 50) {
+    Xoshiro256 rng(DEFAULT_SEED);
+    for (int r = 0; r < rounds; r++) {
+        int n = (int)rng.nextInt(1, 3000);
+        long long m = rng.nextInt(0, 20 * n);
+        Vector<Edge> edges;
+        randomEdges(n, m, 1000, edges, DEFAULT_SEED + r);
+        string text = "# random graph\n";
+        long long line = 1, badLine = -1;
+        long long badAt = rng.nextInt(0, m);
+        int top = -1;
+        for (long long i = 0; i < m; i++) {
+            Edge& e = edges[(int)i];
+            if (rng.nextBelow(20) == 0) {
+                text += rng.nextBelow(2) ? "\n" : "% comment\n";
+                line++;
+            }
+            if (i == badAt) {
+                text += "12 x 3\n";
+                badLine = ++line;
+            }
+            if (rng.nextBelow(10) == 0) e.w = 1;
+            text += to_string(e.u) + (rng.nextBelow(2) ? "\t" : " ") + to_string(e.v);
+            if (e.w != 1 || rng.nextBelow(2)) text += " " + to_string(e.w);
+            text += rng.nextBelow(4) == 0 ? "\r\n" : "\n";
+            line++;
+            if (e.u > top) top = e.u;
+            if (e.v > top) top = e.v;
+        }
+        if (m > 0 && r % 3 == 0) text.pop_back(); // 最后一行没有换行符
+
+        bool directed = r % 2 == 1;
+        CSRGraph expect, g;
+        expect.build(top + 1, edges.data(), m, directed);
+        string good = text;
+        if (badLine >= 0) good.erase(good.find("12 x 3\n"), 7);
+        if (parseEdgeList(good.data(), good.size(), g, directed, 1 + r % 4) != m) return false;
+        if (!sameCSR(g, expect)) return false;
+        if (badLine < 0) continue;
+        try {
+            parseEdgeList(text.data(), text.size(), g, directed, 1 + r % 4);
+            return false;
+        } catch (const runtime_error& ex) {
+            if (string(ex.what()) != "Malformed edge list at line " + to_string(badLine)) return false;
+        }
+    }
+    return true;
+}
+
+// 连通分量个数（跳过顶点 skipV 和边表中的第 skipE 条边），用于暴力校验
+int countComponents(int n, const Vector<Edge>& edges, int skipV, int skipE) {
+    UnionFind uf(n);
+    for (int i = 0; i < edges.size(); i++) {
+        if (i == skipE || edges[i].u == skipV || edges[i].v == skipV) continue;
+        uf.unite(edges[i].u, edges[i].v);
+    }
+    return uf.count() - (skipV >= 0 ? 1 : 0);
+}
+
+// 随机小图上用暴力方法校验迭代版算法：删点 / 删边后分量数增加即关节点 / 桥；
+// 每条非自环边恰好属于一个点双连通分量；强连通分量与传递闭包一致
+bool testConnectivity(int rounds = 200) {
+    Xoshiro256 rng(DEFAULT_SEED);
+    for (int r = 0; r < rounds; r++) {
+        int n = (int)rng.nextInt(1, 30);
+        long long m = rng.nextInt(0, 2 * n);
+        Vector<Edge> edges;
+        randomEdges(n, m, 9, edges, DEFAULT_SEED + r);
+        CSRGraph g;
+        g.build(n, edges.data(), m);
+
+        Vector<bool> isCut;
+        Vector<Edge> bridges;
+        cutVerticesAndBridges(g, isCut, bridges);
+        int base = countComponents(n, edges, -1, -1);
+        for (int v = 0; v < n; v++) {
+            if (isCut[v] != (countComponents(n, edges, v, -1) > base)) return false;
+        }
+        int bridgeCount = 0;
+        for (int i = 0; i < edges.size(); i++) bridgeCount += countComponents(n, edges, -1, i) > base;
+        if (bridgeCount != bridges.size()) return false;
+
+        Vector<int> bccStart;
+        Vector<Edge> bccEdges;
+        int bccs = biconnectedComponents(g, bccStart, bccEdges);
+        int loops = 0;
+        for (int i = 0; i < edges.size(); i++) loops += edges[i].u == edges[i].v;
+        if (bccEdges.size() != edges.size() - loops) return false;
+        // 关节点恰好是出现在两个以上分量中的顶点
+        Vector<int> seen, last;
+        seen.resize(n);
+        last.resize(n);
+        for (int v = 0; v < n; v++) last[v] = -1;
+        for (int k = 0; k < bccs; k++) {
+            for (int i = bccStart[k]; i < bccStart[k + 1]; i++) {
+                int ends[2] = {bccEdges[i].u, bccEdges[i].v};
+                for (int v : ends) {
+                    if (last[v] != k) seen[v]++;
+                    last[v] = k;
+                }
+            }
+        }
+        for (int v = 0; v < n; v++) {
+            if (isCut[v] != (seen[v] >= 2)) return false;
+        }
+
+        // 有向图：u、v 互相可达当且仅当属于同一强连通分量
+        CSRGraph dg;
+        dg.build(n, edges.data(), m, true);
+        Vector<int> comp;
+        stronglyConnectedComponents(dg, comp);
+        Vector<bool> reach;
+        reach.resize(n * n);
+        for (int u = 0; u < n; u++) {
+            Vector<int> order;
+            bfsOrder(dg, u, order);
+            for (int i = 0; i < order.size(); i++) reach[u * n + order[i]] = true;
+        }
+        for (int u = 0; u < n; u++) {
+            for (int v = 0; v < n; v++) {
+                if ((comp[u] == comp[v]) != (reach[u * n + v] && reach[v * n + u])) return false;
+            }
+        }
+    }
+    return true;
+}
+
+// 随机名字（含空串、长名字和大量重复）依次驻留，与 map<string, int> 逐一对照编号和反查结果
+bool testStringInterner(int rounds = 20) {
+    Xoshiro256 rng(DEFAULT_SEED);
+    for (int r = 0; r < rounds; r++) {
+        StringInterner pool;
+        map<string, int> expect;
+        int ops = (int)rng.nextInt(1, 20000);
+        int alphabet = (int)rng.nextInt(1, 26);
+        for (int i = 0; i < ops; i++) {
+            string s((size_t)rng.nextBelow(rng.nextBelow(8) == 0 ? 100 : 6), 'a');
+            for (char& c : s) c = (char)('a' + rng.nextBelow(alphabet));
+            if (rng.nextBelow(3) == 0) { // 只查找
+                auto it = expect.find(s);
+                if (pool.find(s) != (it == expect.end() ? StringInterner::NOT_FOUND : it->second)) return false;
+                continue;
+            }
+            auto it = expect.find(s);
+            int id = it == expect.end() ? (expect[s] = (int)expect.size()) : it->second;
+            if (pool.intern(s) != id) return false;
+        }
+        if (pool.size() != (int)expect.size()) return false;
+        for (auto& kv : expect) {
+            if (pool.name(kv.second) != kv.first) return false;
+        }
+    }
+    return true;
+}
+
+// 批量按名字加边时的名字解析：m 条边的端点名逐个查 map<string, int> 与查驻留表，对比耗时
+void benchNameResolution(int n, long long m) {
+    Vector<Edge> edges;
+    randomEdges(n, m, 1, edges);
+    Vector<string> names;
+    names.resize(n);
+    for (int i = 0; i < n; i++) names[i] = "v" + to_string((long long)i * 2654435761LL % 1000000007);
+
+    auto t0 = chrono::steady_clock::now();
+    map<string, int> tree;
+    for (int i = 0; i < n; i++) tree[names[i]] = i;
+    long long sumTree = 0;
+    for (int i = 0; i < m; i++) sumTree += tree[names[edges[i].u]] + tree[names[edges[i].v]];
+    auto t1 = chrono::steady_clock::now();
+    StringInterner pool;
+    pool.reserve(n);
+    for (int i = 0; i < n; i++) pool.intern(names[i]);
+    long long sumPool = 0;
+    for (int i = 0; i < m; i++) sumPool += pool.find(names[edges[i].u]) + pool.find(names[edges[i].v]);
+    auto t2 = chrono::steady_clock::now();
+
+    cout << "\n=== 顶点名解析（" << n << " 个名字，" << m << " 条边）===" << endl;
+    cout << "map<string, int> " << chrono::duration<double>(t1 - t0).count() << " s，驻留表 "
+         << chrono::duration<double>(t2 - t1).count() << " s（占用 " << pool.memoryBytes() / 1e6 << " MB），"
+         << (sumTree == sumPool ? "编号一致" : "编号不一致！") << endl;
+}
+
+// 长链（0 - 1 - ... - n-1，有向图中为单向链）：递归实现需要 n 层调用，这里全部用显式栈
+void testDeepChain(int n) {
+    CSRGraph g, dg;
+    {
+        Vector<Edge> edges;
+        edges.resize(n - 1);
+        for (int i = 0; i + 1 < n; i++) edges[i] = {i, i + 1, 1};
+        g.build(n, edges.data(), n - 1);
+        dg.build(n, edges.data(), n - 1, true);
+    }
+    auto t0 = chrono::steady_clock::now();
+    Vector<int> order;
+    dfsOrder(g, 0, order);
+    auto t1 = chrono::steady_clock::now();
+    Vector<bool> isCut;
+    Vector<Edge> bridges;
+    cutVerticesAndBridges(g, isCut, bridges);
+    auto t2 = chrono::steady_clock::now();
+    Vector<int> comp;
+    int sccs = stronglyConnectedComponents(dg, comp);
+    auto t3 = chrono::steady_clock::now();
+    int cuts = 0;
+    for (int v = 0; v < n; v++) cuts += isCut[v];
+    cout << "\n=== 长链（" << n << " 个顶点）===" << endl;
+    cout << "DFS 访问 " << order.size() << " 个顶点（" << chrono::duration<double>(t1 - t0).count() << " s），关节点 "
+         << cuts << " 个、桥 " << bridges.size() << " 条（" << chrono::duration<double>(t2 - t1).count()
+         << " s），有向强连通分量 " << sccs << " 个（" << chrono::duration<double>(t3 - t2).count() << " s）" << endl;
+}
+
+// 随机小图（含不连通的情形）上对比三种最小生成森林算法：总权重相同，边数都等于 V - 连通分量数
+bool testSpanningForest(int rounds = 200) {
+    Xoshiro256 rng(DEFAULT_SEED);
+    for (int r = 0; r < rounds; r++) {
+        int n = (int)rng.nextInt(1, 80);
+        long long m = rng.nextInt(0, 3 * n);
+        Vector<Edge> edges;
+        randomEdges(n, m, r % 3 == 0 ? 5 : 1000, edges, DEFAULT_SEED + r); // 小权重时大量并列
+        CSRGraph g;
+        g.build(n, edges.data(), m);
+        UnionFind uf(n);
+        for (long long i = 0; i < m; i++) uf.unite(edges[i].u, edges[i].v);
+        Vector<int> parent, key;
+        Vector<Edge> kf, bf;
+        long long wp = primForest(g, (int)rng.nextBelow(n), parent, key);
+        long long wk = kruskal(n, edges.data(), m, kf);
+        long long wb = boruvka(n, edges.data(), m, bf, 1 + r % 4);
+        int treeEdges = 0;
+        for (int v = 0; v < n; v++) treeEdges += parent[v] != -1;
+        if (wp != wk || wk != wb) return false;
+        if (treeEdges != n - uf.count() || kf.size() != n - uf.count() || bf.size() != n - uf.count()) return false;
+    }
+    return true;
+}
+
+// 随机小图上对比堆优化 Dijkstra 与线性扫描版本的距离
+bool testDijkstra(int rounds = 200) {
+    Xoshiro256 rng(DEFAULT_SEED);
+    for (int r = 0; r < rounds; r++) {
+        int n = (int)rng.nextInt(1, 60);
+        long long m = rng.nextInt(0, 4 * n);
+        Vector<Edge> edges;
+        randomEdges(n, m, 1000, edges, DEFAULT_SEED + r);
+        CSRGraph g;
+        g.build(n, edges.data(), m, r % 2 == 1);
+        int s = (int)rng.nextBelow(n);
+        Vector<int> expect, pred, path;
+        Vector<long long> dist;
+        dijkstraScan(g, s, expect);
+        dijkstra(g, s, dist, pred);
+        for (int v = 0; v < n; v++) {
+            long long want = expect[v] == INT_MAX ? INF_DIST : expect[v];
+            if (dist[v] != want) return false;
+            // 沿前驱路径累加的权重应等于最短距离
+            buildPath(pred, s, v, path);
+            if (dist[v] == INF_DIST) continue;
+            long long len = 0;
+            for (int k = 0; k + 1 < path.size(); k++) {
+                long long best = INF_DIST;
+                for (long long e = g.begin(path[k]); e < g.end(path[k]); e++) {
+                    if (g.target(e) == path[k + 1]) best = min(best, (long long)g.weight(e));
+                }
+                len += best;
+            }
+            if (path[0] != s || path[path.size() - 1] != v || len != dist[v]) return false;
+        }
+    }
+    return true;
+}
+
+// 载入图文件：以 CSRG 文件头开始的按快照映射，否则按边表文本解析
+void loadGraphFile(const char* path, CSRGraph& g, bool directed, int threads) {
+    char magic[4] = {0};
+    FILE* fp = fopen(path, "rb");
+    if (!fp) throw runtime_error(string("Cannot open ") + path);
+    size_t got = fread(magic, 1, 4, fp);
+    fclose(fp);
+    if (got == 4 && memcmp(magic, CSR_MAGIC, 4) == 0) {
+        if (!g.loadSnapshot(path, threads)) throw runtime_error(string("Cannot open ") + path);
+    } else if (loadEdgeList(path, g, directed, threads) < 0) {
+        throw runtime_error(string("Cannot open ") + path);
+    }
+}
+
+// 命令行：exp3 gen <顶点数> <边数> <边表> | convert <边表> <快照> [directed] | load <边表|快照> [directed]
+// 线程数由环境变量 GRAPH_THREADS 指定，缺省使用全部硬件线程
+int runCommand(int argc, char* argv[]) {
+    string mode = argv[1];
+    const char* threadEnv = getenv("GRAPH_THREADS");
+    int threads = threadEnv ? atoi(threadEnv) : 0;
+    try {
+        if (mode == "gen" && argc >= 5) {
+            int n = atoi(argv[2]);
+            long long m = atoll(argv[3]);
+            if (n <= 0 || m < 0 || m > INT_MAX) throw runtime_error("Invalid graph size");
+            Vector<Edge> edges;
+            randomEdges(n, m, 100, edges);
+            if (!saveEdgeList(argv[4], edges.data(), m)) throw runtime_error(string("Cannot write ") + argv[4]);
+            cerr << "gen：" << n << " 个顶点，" << m << " 条边 -> " << argv[4] << endl;
+            return 0;
+        }
+        if (mode == "convert" && argc >= 4) {
+            bool directed = argc >= 5 && string(argv[4]) == "directed";
+            CSRGraph g;
+            auto t0 = chrono::steady_clock::now();
+            long long m = loadEdgeList(argv[2], g, directed, threads);
+            if (m < 0) throw runtime_error(string("Cannot open ") + argv[2]);
+            auto t1 = chrono::steady_clock::now();
+            if (!g.saveSnapshot(argv[3])) throw runtime_error(string("Cannot write ") + argv[3]);
+            auto t2 = chrono::steady_clock::now();
+            cerr << "convert：" << g.vertexCount() << " 个顶点，" << m << " 条边，解析建图 "
+                 << chrono::duration<double>(t1 - t0).count() << " s，写快照 "
+                 << chrono::duration<double>(t2 - t1).count() << " s" << endl;
+            return 0;
+        }
+        if (mode == "load" && argc >= 3) {
+            bool directed = argc >= 4 && string(argv[3]) == "directed";
+            CSRGraph g;
+            auto t0 = chrono::steady_clock::now();
+            loadGraphFile(argv[2], g, directed, threads);
+            auto t1 = chrono::steady_clock::now();
+            cout << (g.mapped() ? "快照映射" : "边表解析") << "：" << g.vertexCount() << " 个顶点，"
+                 << g.arcCount() << " 条弧（" << (g.directed() ? "有向" : "无向") << "），耗时 "
+                 << chrono::duration<double>(t1 - t0).count() << " s" << endl;
+            if (g.vertexCount() > 0) {
+                Vector<int> depth, parent;
+                BFSStats bfs = parallelBFS(g, 0, depth, parent, threads);
+                cout << "从顶点 0 并行 BFS：访问 " << bfs.visited << " 个顶点，" << bfs.levels << " 层，"
+                     << bfs.seconds << " s，" << bfs.teps() / 1e6 << " MTEPS" << endl;
+            }
+            return 0;
+        }
+    } catch (const exception& e) {
+        cerr << "Error: " << e.what() << endl;
+        return 1;
+    }
+    cerr << "用法：" << argv[0] << " [长链顶点数]   （演示与随机测试）" << endl
+         << "      " << argv[0] << " gen <顶点数> <边数> <边表>   （随机边表，每行 \"u v w\"）" << endl
+         << "      " << argv[0] << " convert <边表> <快照> [directed]" << endl
+         << "      " << argv[0] << " load <边表|快照> [directed]" << endl;
+    return 2;
+}
+
+// 用法：exp3 [长链顶点数]（缺省 500 万），其余子命令见 runCommand
+int main(int argc, char* argv[]) {
+    if (argc >= 2 && (argv[1][0] < '0' || argv[1][0] > '9')) return runCommand(argc, argv);
+    int chainLength = argc >= 2 ? atoi(argv[1]) : 5000000;
+    if (chainLength < 2) chainLength = 2;
     cout << "===== 图算法实验（exp3）=====" << endl;
     Vector<string> vertexList;
     vertexList.push_back("A");
@@ -273,7 +1928,25 @@ int main() {
     graph.DFS("A");
     graph.dijkstra("A");
     graph.prim("A");
+    graph.kruskal();
     graph.findCutVertices();
+    try {
+        graph.addEdge("A", "Z", 1);
+    } catch (const runtime_error& e) {
+        cout << "\n加边 A - Z 被拒绝：" << e.what() << endl;
+    }
+
+    cout << "\n堆优化 Dijkstra 随机测试：" << (testDijkstra() ? "与线性扫描一致" : "结果不一致！") << endl;
+    cout << "最小生成森林随机测试：" << (testSpanningForest() ? "Prim / Kruskal / Borůvka 一致" : "结果不一致！") << endl;
+    cout << "关节点 / 桥 / 点双连通 / 强连通随机测试：" << (testConnectivity() ? "与暴力结果一致" : "结果不一致！") << endl;
+    cout << "位图随机测试：" << (testBitmap() ? "计数 / 枚举 / rank / select / 批量运算均正确" : "结果错误！") << endl;
+    cout << "并行 BFS 随机测试：" << (testParallelBFS() ? "层数与父节点均正确" : "结果错误！") << endl;
+    cout << "delta-stepping 随机测试：" << (testDeltaStepping() ? "与 Dijkstra 一致" : "结果不一致！") << endl;
+    cout << "边表并行解析随机测试：" << (testEdgeListParser() ? "与直接建图一致" : "结果不一致！") << endl;
+    cout << "字符串驻留表随机测试：" << (testStringInterner() ? "与 map 一致" : "结果不一致！") << endl;
+    testLargeGraph(1 << 20, 4LL << 20);
+    benchNameResolution(1 << 18, 1LL << 20);
+    testDeepChain(chainLength);
 
     cout << "\n===== 实验结束 =====" << endl;
     return 0;
@@ -1,20 +1,18 @@
 #include "MySTL/Vector.h"
 #include "MySTL/list.h"
 #include "MySTL/Stack.h"
+#include "MySTL/Random.h"
 #include <iostream>
 #include <ctime>
 #include <cstdlib>
 #include <iomanip>
 using namespace std;
 
-// 生成随机数组（范围：[minVal, maxVal]，长度：n）
-Vector<int> generateRandomArray(int n, int minVal = 0, int maxVal = 10000) {
-    Vector<int> arr;
-    srand((unsigned int)time(nullptr)); // 随机种子
-    for (int i = 0; i < n; i++) {
-        int val = minVal + rand() % (maxVal - minVal + 1);
-        arr.push_back(val);
-    }
+// 生成随机数组（范围：[minVal, maxVal]，长度：n；同一种子结果相同，大数组多线程生成）
+Vector<int> generateRandomArray(int n, int minVal = 0, int maxVal = 10000, uint64_t seed = DEFAULT_SEED) {
+    Vector<int> arr(max(n, 1));
+    arr.resize(n);
+    parallelFillInt(arr.data(), n, minVal, maxVal, seed);
     return arr;
 }
 